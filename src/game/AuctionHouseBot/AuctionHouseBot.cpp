@@ -2210,6 +2210,9 @@ void AuctionHouseBot::Rebuild(bool all)
                 }
             }
         }
+
+        // duration column changed
+        sAuctionMgr.GetAuctionsMap(AuctionHouseType(i))->InvalidateSortedViews();
     }
 }
 
@@ -116,7 +116,7 @@ bool FleeingMovementGenerator<T>::_getPoint(T& owner, float& x, float& y, float&
     y = curr_y + dist * sin(angle);
     z = curr_z + 0.5f;
 
-    // try to fix z
+    // try to fix z, a single point; the heights along the path are looked up in one batch by PathFinder
     if (!owner.GetMap()->GetHeightInRange(owner.GetPhaseMask(), x, y, z))
     {
         return false;
@@ -28,13 +28,117 @@
 #include "GridMap.h"
 #include "Creature.h"
 #include "PathFinder.h"
+#include "Map.h"
 #include "Log.h"
 
+#include <ace/High_Res_Timer.h>
+
+////////////////// PathCache //////////////////
+static ACE_Atomic_Op<ACE_Thread_Mutex, uint64> s_pathRequests = 0;
+static ACE_Atomic_Op<ACE_Thread_Mutex, uint64> s_pathCacheHits = 0;
+static ACE_Atomic_Op<ACE_Thread_Mutex, uint64> s_pathTimeUs = 0;
+
+bool PathCache::Key::operator<(Key const& other) const
+{
+    if (startPoly != other.startPoly)
+    {
+        return startPoly < other.startPoly;
+    }
+
+    if (endPoly != other.endPoly)
+    {
+        return endPoly < other.endPoly;
+    }
+
+    if (includeFlags != other.includeFlags)
+    {
+        return includeFlags < other.includeFlags;
+    }
+
+    return excludeFlags < other.excludeFlags;
+}
+
+PathCache::PathCache(Map const* map) :
+    m_map(map), m_tickRequests(0), m_tickCacheHits(0), m_tickTimeUs(0)
+{
+}
+
+PathCache::Key PathCache::MakeKey(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter)
+{
+    Key key;
+    key.startPoly = startPoly;
+    key.endPoly = endPoly;
+    key.includeFlags = filter.getIncludeFlags();
+    key.excludeFlags = filter.getExcludeFlags();
+    return key;
+}
+
+bool PathCache::Find(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef* path, uint32& pathLength) const
+{
+    PathMap::const_iterator itr = m_paths.find(MakeKey(startPoly, endPoly, filter));
+    if (itr == m_paths.end())
+    {
+        return false;
+    }
+
+    pathLength = itr->second.size();
+    memcpy(path, &itr->second[0], pathLength * sizeof(dtPolyRef));
+    return true;
+}
+
+void PathCache::Store(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef const* path, uint32 pathLength)
+{
+    MANGOS_ASSERT(pathLength > 0 && pathLength <= MAX_PATH_LENGTH);
+
+    m_paths[MakeKey(startPoly, endPoly, filter)].assign(path, path + pathLength);
+}
+
+void PathCache::AddRequest(uint64 timeUs, bool cacheHit)
+{
+    ++m_tickRequests;
+    m_tickTimeUs += timeUs;
+    if (cacheHit)
+    {
+        ++m_tickCacheHits;
+    }
+}
+
+void PathCache::NewTick()
+{
+    m_paths.clear();
+
+    if (!m_tickRequests)
+    {
+        return;
+    }
+
+    DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "Map %u (instance %u): %u path requests, %u from cache, " UI64FMTD " us",
+                     m_map->GetId(), m_map->GetInstanceId(), m_tickRequests, m_tickCacheHits, m_tickTimeUs);
+
+    s_pathRequests += m_tickRequests;
+    s_pathCacheHits += m_tickCacheHits;
+    s_pathTimeUs += m_tickTimeUs;
+
+    m_tickRequests = 0;
+    m_tickCacheHits = 0;
+    m_tickTimeUs = 0;
+}
+
+PathFindingStats PathCache::GetStats()
+{
+    PathFindingStats stats;
+    stats.requests = s_pathRequests.value();
+    stats.cacheHits = s_pathCacheHits.value();
+    stats.timeUs = s_pathTimeUs.value();
+    return stats;
+}
+
 ////////////////// PathFinder //////////////////
 PathFinder::PathFinder(const Unit* owner) :
     m_polyLength(0), m_type(PATHFIND_BLANK),
     m_useStraightPath(false), m_forceDestination(false), m_pointPathLimit(MAX_POINT_PATH_LENGTH),
-    m_sourceUnit(owner), m_navMesh(NULL), m_navMeshQuery(NULL)
+    m_sourceUnit(owner), m_navMesh(NULL), m_navMeshQuery(NULL),
+    m_pathCache(NULL), m_pathFromCache(false)
 {
     DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ PathFinder::PathInfo for %u \n", m_sourceUnit->GetGUIDLow());
 
@@ -81,7 +185,23 @@ bool PathFinder::calculate(float destX, float destY, float destZ, bool forceDest
 
     updateFilter();
 
+    // the owner may have changed maps since the last call
+    m_pathCache = m_sourceUnit->IsInWorld() ? m_sourceUnit->GetMap()->GetPathCache() : NULL;
+    m_pathFromCache = false;
+
+    ACE_High_Res_Timer timer;
+    timer.start();
+
     BuildPolyPath(start, dest);
+
+    timer.stop();
+    if (m_pathCache)
+    {
+        ACE_hrtime_t elapsed;
+        timer.elapsed_microseconds(elapsed);
+        m_pathCache->AddRequest(uint64(elapsed), m_pathFromCache);
+    }
+
     return true;
 }
 
@@ -389,23 +509,37 @@ void PathFinder::BuildPolyPath(const Vector3& startPos, const Vector3& endPos)
         // free and invalidate old path data
         clear();
 
-        dtResult = m_navMeshQuery->findPath(
-                       startPoly,          // start polygon
-                       endPoly,            // end polygon
-                       startPoint,         // start position
-                       endPoint,           // end position
-                       &m_filter,           // polygon search filter
-                       m_pathPolyRefs,     // [out] path
-                       (int*)&m_polyLength,
-                       MAX_PATH_LENGTH);   // max number of polygons in output path
-
-        if (!m_polyLength || dtStatusFailed(dtResult))
+        // another unit may have searched between the same polygons this tick
+        if (m_pathCache && m_pathCache->Find(startPoly, endPoly, m_filter, m_pathPolyRefs, m_polyLength))
         {
-            // only happens if we passed bad data to findPath(), or navmesh is messed up
-            sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
-            BuildShortcut();
-            m_type = PATHFIND_NOPATH;
-            return;
+            DEBUG_FILTER_LOG(LOG_FILTER_PATHFINDING, "++ BuildPolyPath :: poly path taken from map path cache\n");
+            m_pathFromCache = true;
+        }
+        else
+        {
+            dtResult = m_navMeshQuery->findPath(
+                           startPoly,          // start polygon
+                           endPoly,            // end polygon
+                           startPoint,         // start position
+                           endPoint,           // end position
+                           &m_filter,           // polygon search filter
+                           m_pathPolyRefs,     // [out] path
+                           (int*)&m_polyLength,
+                           MAX_PATH_LENGTH);   // max number of polygons in output path
+
+            if (!m_polyLength || dtStatusFailed(dtResult))
+            {
+                // only happens if we passed bad data to findPath(), or navmesh is messed up
+                sLog.outError("%u's Path Build failed: 0 length path", m_sourceUnit->GetGUIDLow());
+                BuildShortcut();
+                m_type = PATHFIND_NOPATH;
+                return;
+            }
+
+            if (m_pathCache)
+            {
+                m_pathCache->Store(startPoly, endPoly, m_filter, m_pathPolyRefs, m_polyLength);
+            }
         }
     }
 
@@ -844,9 +978,22 @@ float PathFinder::dist3DSqr(const Vector3& p1, const Vector3& p2) const
 
 void PathFinder::NormalizePath(uint32& size)
 {
-    for (uint32 i = 0; i < m_pathPoints.size(); ++i)
+    if (uint32 count = m_pathPoints.size())
     {
-        m_sourceUnit->UpdateAllowedPositionZ(m_pathPoints[i].x, m_pathPoints[i].y, m_pathPoints[i].z);
+        std::vector<float> x(count), y(count), z(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            x[i] = m_pathPoints[i].x;
+            y[i] = m_pathPoints[i].y;
+            z[i] = m_pathPoints[i].z;
+        }
+
+        m_sourceUnit->UpdateAllowedPositionZ(count, &x[0], &y[0], &z[0]);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            m_pathPoints[i].z = z[i];
+        }
     }
 
     // check if the Z difference between each point is higher than SMOOTH_PATH_HEIGHT.
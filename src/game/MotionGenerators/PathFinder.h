@@ -34,7 +34,11 @@
 using Movement::Vector3;
 using Movement::PointsArray;
 
+#include <map>
+#include <vector>
+
 class Unit;
+class Map;
 
 // 74*4.0f=296y  number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -59,6 +63,58 @@ enum PathType
     PATHFIND_NOT_USING_PATH = 0x0010    // used when we are either flying/swiming or on map w/o mmaps
 };
 
+// Summed path finding work of all maps since startup
+struct PathFindingStats
+{
+    uint64 requests;                    // PathFinder::calculate calls on maps with a navmesh
+    uint64 cacheHits;                   // poly paths taken from a map's PathCache
+    uint64 timeUs;                      // time spent in PathFinder::calculate
+};
+
+// Poly paths found on one map during the current tick.
+// Units moving between the same two polygons with the same filter (a pack
+// chasing one target) share a single findPath() search instead of each
+// running their own. The cache is emptied at the start of every map update,
+// so it never holds refs to tiles unloaded between updates.
+class PathCache
+{
+    public:
+        PathCache(Map const* map);
+
+        bool Find(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef* path, uint32& pathLength) const;
+        void Store(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter, dtPolyRef const* path, uint32 pathLength);
+
+        // account a path request of the current tick
+        void AddRequest(uint64 timeUs, bool cacheHit);
+
+        // drop the cached paths and report the work of the finished tick
+        void NewTick();
+
+        static PathFindingStats GetStats();
+
+    private:
+        struct Key
+        {
+            dtPolyRef startPoly;
+            dtPolyRef endPoly;
+            uint16 includeFlags;
+            uint16 excludeFlags;
+
+            bool operator<(Key const& other) const;
+        };
+
+        typedef std::map<Key, std::vector<dtPolyRef> > PathMap;
+
+        static Key MakeKey(dtPolyRef startPoly, dtPolyRef endPoly, dtQueryFilter const& filter);
+
+        Map const* m_map;
+        PathMap m_paths;
+
+        uint32 m_tickRequests;
+        uint32 m_tickCacheHits;
+        uint64 m_tickTimeUs;
+};
+
 class PathFinder
 {
     public:
@@ -101,6 +157,8 @@ class PathFinder
         const Unit* const       m_sourceUnit;       // the unit that is moving
         const dtNavMesh*        m_navMesh;          // the nav mesh
         const dtNavMeshQuery*   m_navMeshQuery;     // the nav mesh query used to find the path
+        PathCache*              m_pathCache;        // poly paths found on the owner's map this tick
+        bool                    m_pathFromCache;    // last poly path was taken from m_pathCache
 
         dtQueryFilter m_filter;                     // use single filter for all movements, update it when needed
 
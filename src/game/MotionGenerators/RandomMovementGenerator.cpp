@@ -54,6 +54,7 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature& creature)
     creature.addUnitState(UNIT_STAT_ROAMING_MOVE);
 
     // check if new random position is assigned, GetReachableRandomPosition may fail
+    // only the destination is looked up here, the path heights are batched by PathFinder
     if (creature.GetMap()->GetReachableRandomPosition(&creature, destX, destY, destZ, i_radius))
     {
         Movement::MoveSplineInit init(creature);
@@ -632,6 +632,7 @@ void AuctionHouseObject::Update()
 
                 itr->second->DeleteFromDB();
                 MANGOS_ASSERT(!itr->second->itemGuidLow);   // already removed or send in mail at won
+                UnindexAuction(itr->second);
                 delete itr->second;
                 AuctionsMap.erase(itr++);
                 continue;
@@ -652,6 +653,7 @@ void AuctionHouseObject::Update()
                     sAuctionMgr.SendAuctionExpiredMail(itr->second);
 
                     itr->second->DeleteFromDB();
+                    UnindexAuction(itr->second);
                     delete itr->second;
                     AuctionsMap.erase(itr++);
                     continue;
@@ -663,6 +665,65 @@ void AuctionHouseObject::Update()
     }
 }
 
+void AuctionHouseObject::IndexAuction(AuctionEntry* ah)
+{
+    m_templateIndex[ah->itemTemplate].insert(ah);
+    InvalidateSortedViews();
+}
+
+void AuctionHouseObject::UnindexAuction(AuctionEntry* ah)
+{
+    AuctionTemplateIndex::iterator itr = m_templateIndex.find(ah->itemTemplate);
+    if (itr != m_templateIndex.end())
+    {
+        itr->second.erase(ah);
+        if (itr->second.empty())
+        {
+            m_templateIndex.erase(itr);
+        }
+    }
+
+    InvalidateSortedViews();
+}
+
+AuctionHouseObject::AuctionEntryList const& AuctionHouseObject::GetSortedAuctions(uint8 const* sort, Player* viewPlayer)
+{
+    int32 locale = viewPlayer->GetSession()->GetSessionDbLocaleIndex();
+
+    for (std::vector<SortedView>::const_iterator itr = m_sortedViews.begin(); itr != m_sortedViews.end(); ++itr)
+    {
+        if (itr->locale == locale && !memcmp(itr->sort, sort, MAX_AUCTION_SORT))
+        {
+            return itr->auctions;
+        }
+    }
+
+    // clients use a handful of orders, start over rather than tracking usage
+    if (m_sortedViews.size() >= MAX_AUCTION_SORTED_VIEWS)
+    {
+        m_sortedViews.clear();
+    }
+
+    m_sortedViews.push_back(SortedView());
+    SortedView& view = m_sortedViews.back();
+    memcpy(view.sort, sort, MAX_AUCTION_SORT);
+    view.locale = locale;
+
+    view.auctions.reserve(AuctionsMap.size());
+    for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
+    {
+        view.auctions.push_back(itr->second);
+    }
+
+    if (sort[0] != MAX_AUCTION_SORT)
+    {
+        AuctionSorter sorter(view.sort, viewPlayer);
+        std::sort(view.auctions.begin(), view.auctions.end(), sorter);
+    }
+
+    return view.auctions;
+}
+
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
 {
     for (AuctionEntryMap::const_iterator itr = AuctionsMap.begin(); itr != AuctionsMap.end(); ++itr)
@@ -913,32 +974,25 @@ bool AuctionSorter::operator()(const AuctionEntry* auc1, const AuctionEntry* auc
     return false;                                           // "equal" by all sorts
 }
 
-void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
+void WorldSession::BuildListAuctionItems(AuctionHouseObject* auctionHouse, uint8* sort, WorldPacket& data, std::wstring const& wsearchedname, uint32 listfrom, uint32 levelmin,
         uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull)
 {
     int loc_idx = _player->GetSession()->GetSessionDbLocaleIndex();
 
-    for (std::vector<AuctionEntry*>::const_iterator itr = auctions.begin(); itr != auctions.end(); ++itr)
-    {
-        AuctionEntry* Aentry = *itr;
-        if (Aentry->moneyDeliveryTime)
-        {
-            continue;
-        }
-        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
-        if (!item)
-        {
-            continue;
-        }
+    ///- Check the item template filters and the name once per template present in the house
+    AuctionHouseObject::AuctionTemplateIndex const& templateIndex = auctionHouse->GetTemplateIndex();
+    std::set<uint32> matchedTemplates;
+    size_t matchedAuctions = 0;
 
-        if (isFull)
-        {
-            ++count;
-            Aentry->BuildAuctionInfo(data);
-        }
-        else
+    if (!isFull)
+    {
+        for (AuctionHouseObject::AuctionTemplateIndex::const_iterator itr = templateIndex.begin(); itr != templateIndex.end(); ++itr)
         {
-            ItemPrototype const* proto = item->GetProto();
+            ItemPrototype const* proto = ObjectMgr::GetItemPrototype(itr->first);
+            if (!proto)
+            {
+                continue;
+            }
 
             if (itemClass != 0xffffffff && proto->Class != itemClass)
             {
@@ -965,8 +1019,75 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
                 continue;
             }
 
+            if (!wsearchedname.empty())
+            {
+                std::string name = proto->Name1;
+                sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
+
+                if (!Utf8FitTo(name, wsearchedname))
+                {
+                    continue;
+                }
+            }
+
+            matchedTemplates.insert(itr->first);
+            matchedAuctions += itr->second.size();
+        }
+    }
+
+    ///- Narrow searches only sort their own auctions, wide ones walk the cached order of the house
+    AuctionHouseObject::AuctionEntryList candidates;
+    AuctionHouseObject::AuctionEntryList const* auctions = &candidates;
+
+    if (isFull || matchedAuctions * 4 >= auctionHouse->GetCount())
+    {
+        auctions = &auctionHouse->GetSortedAuctions(sort, _player);
+    }
+    else
+    {
+        candidates.reserve(matchedAuctions);
+        for (std::set<uint32>::const_iterator itr = matchedTemplates.begin(); itr != matchedTemplates.end(); ++itr)
+        {
+            AuctionHouseObject::AuctionEntrySet const& templateAuctions = templateIndex.find(*itr)->second;
+            candidates.insert(candidates.end(), templateAuctions.begin(), templateAuctions.end());
+        }
+
+        if (sort[0] != MAX_AUCTION_SORT)
+        {
+            AuctionSorter sorter(sort, _player);
+            std::sort(candidates.begin(), candidates.end(), sorter);
+        }
+    }
+
+    for (AuctionHouseObject::AuctionEntryList::const_iterator itr = auctions->begin(); itr != auctions->end(); ++itr)
+    {
+        AuctionEntry* Aentry = *itr;
+        if (Aentry->moneyDeliveryTime)
+        {
+            continue;
+        }
+        Item* item = sAuctionMgr.GetAItem(Aentry->itemGuidLow);
+        if (!item)
+        {
+            continue;
+        }
+
+        if (isFull)
+        {
+            ++count;
+            Aentry->BuildAuctionInfo(data);
+        }
+        else
+        {
+            if (matchedTemplates.find(Aentry->itemTemplate) == matchedTemplates.end())
+            {
+                continue;
+            }
+
             if (usable != 0x00)
             {
+                ItemPrototype const* proto = item->GetProto();
+
                 if (_player->CanUseItem(item) != EQUIP_ERR_OK)
                 {
                     continue;
@@ -990,14 +1111,6 @@ void WorldSession::BuildListAuctionItems(std::vector<AuctionEntry*> const& aucti
                 }
             }
 
-            std::string name = proto->Name1;
-            sObjectMgr.GetItemLocaleStrings(proto->ItemId, loc_idx, &name);
-
-            if (!wsearchedname.empty() && !Utf8FitTo(name, wsearchedname))
-            {
-                continue;
-            }
-
             if (count < 50 && totalcount >= listfrom)
             {
                 ++count;
@@ -1193,6 +1306,9 @@ bool AuctionEntry::UpdateBid(uint64 newbid, Player* newbidder /*=NULL*/)
     bidder = newbidder ? newbidder->GetGUIDLow() : 0;
     bid = newbid;
 
+    // bid and status columns changed
+    sAuctionMgr.GetAuctionsMap(auctionHouseEntry)->InvalidateSortedViews();
+
     if ((newbid < buyout) || (buyout == 0))                 // bid
     {
         if (auction_owner)
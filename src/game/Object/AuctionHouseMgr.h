@@ -54,6 +54,7 @@ class WorldPacket;
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_SORT 12
 #define AUCTION_SORT_REVERSED 0x10
+#define MAX_AUCTION_SORTED_VIEWS 8
 
 /**
  * Documentation for this taken directly from comments in source
@@ -129,15 +130,29 @@ class AuctionHouseObject
         typedef std::map<uint32, AuctionEntry*> AuctionEntryMap;
         typedef std::pair<AuctionEntryMap::const_iterator, AuctionEntryMap::const_iterator> AuctionEntryMapBounds;
 
+        typedef std::vector<AuctionEntry*> AuctionEntryList;
+        typedef std::set<AuctionEntry*> AuctionEntrySet;
+        typedef std::map<uint32, AuctionEntrySet> AuctionTemplateIndex;
+
         uint32 GetCount() { return AuctionsMap.size(); }
 
         AuctionEntryMap const& GetAuctions() const { return AuctionsMap; }
         AuctionEntryMapBounds GetAuctionsBounds() const {return AuctionEntryMapBounds(AuctionsMap.begin(), AuctionsMap.end()); }
 
+        /// auctions grouped by item template, search filters are checked once per template
+        AuctionTemplateIndex const& GetTemplateIndex() const { return m_templateIndex; }
+
+        /// all auctions ordered by the client sort columns, kept until an auction changes
+        AuctionEntryList const& GetSortedAuctions(uint8 const* sort, Player* viewPlayer);
+
+        /// drop the cached orders, must be called when a sorted column of an auction changes
+        void InvalidateSortedViews() { m_sortedViews.clear(); }
+
         void AddAuction(AuctionEntry* ah)
         {
             MANGOS_ASSERT(ah);
             AuctionsMap[ah->Id] = ah;
+            IndexAuction(ah);
         }
 
         AuctionEntry* GetAuction(uint32 id) const
@@ -148,7 +163,15 @@ class AuctionHouseObject
 
         bool RemoveAuction(uint32 id)
         {
-            return AuctionsMap.erase(id);
+            AuctionEntryMap::iterator itr = AuctionsMap.find(id);
+            if (itr == AuctionsMap.end())
+            {
+                return false;
+            }
+
+            UnindexAuction(itr->second);
+            AuctionsMap.erase(itr);
+            return true;
         }
 
         void Update();
@@ -159,7 +182,19 @@ class AuctionHouseObject
 
         AuctionEntry* AddAuction(AuctionHouseEntry const* auctionHouseEntry, Item* newItem, uint32 etime, uint64 bid, uint64 buyout = 0, uint64 deposit = 0, Player* pl = NULL);
     private:
+        struct SortedView
+        {
+            uint8 sort[MAX_AUCTION_SORT];
+            int32 locale;                                   // name column depends on the viewer locale
+            AuctionEntryList auctions;
+        };
+
+        void IndexAuction(AuctionEntry* ah);
+        void UnindexAuction(AuctionEntry* ah);
+
         AuctionEntryMap AuctionsMap;
+        AuctionTemplateIndex m_templateIndex;
+        std::vector<SortedView> m_sortedViews;
 };
 
 class AuctionSorter
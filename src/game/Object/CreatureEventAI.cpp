@@ -103,10 +103,11 @@ inline bool IsEventFlagsFitForNormalMap(uint8 eFlags)
 }
 
 CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
+    m_EventTypeMask(0),
+    m_HasEventCooldowns(false),
     m_Phase(0),
     m_MeleeEnabled(true),
     m_DynamicMovement(false),
-    m_HasOOCLoSEvent(false),
     m_InvinceabilityHpLevel(0),
     m_throwAIEventMask(0),
     m_throwAIEventStep(0),
@@ -173,11 +174,6 @@ CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
                 if (storeEvent)
                 {
                     m_CreatureEventAIList.push_back(CreatureEventAIHolder(*i));
-                    // Cache for fast use
-                    if (i->event_type == EVENT_T_OOC_LOS)
-                    {
-                        m_HasOOCLoSEvent = true;
-                    }
                 }
             }
         }
@@ -186,6 +182,8 @@ CreatureEventAI::CreatureEventAI(Creature* c) : CreatureAI(c),
     {
         sLog.outErrorEventAI("EventMap for Creature %u is empty but creature is using CreatureEventAI.", m_creature->GetEntry());
     }
+
+    BuildEventTypeIndex();
 }
 
 #define LOG_PROCESS_EVENT                                                                                                       \
@@ -216,6 +214,39 @@ inline bool IsTimerBasedEvent(EventAI_Type type)
     }
 }
 
+void CreatureEventAI::BuildEventTypeIndex()
+{
+    memset(m_EventTypeStart, 0, sizeof(m_EventTypeStart));
+    m_EventTypeMask = 0;
+
+    // Count the events of each type, then turn the counts into start offsets
+    for (CreatureEventAIList::const_iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    {
+        ++m_EventTypeStart[itr->Event.event_type + 1];
+        m_EventTypeMask |= 1u << itr->Event.event_type;
+    }
+
+    for (uint32 type = 0; type < EVENT_T_END; ++type)
+    {
+        m_EventTypeStart[type + 1] += m_EventTypeStart[type];
+    }
+
+    uint16 next[EVENT_T_END];
+    memcpy(next, m_EventTypeStart, sizeof(next));
+
+    m_EventsByType.resize(m_CreatureEventAIList.size());
+    for (uint16 i = 0; i < m_CreatureEventAIList.size(); ++i)
+    {
+        EventAI_Type type = EventAI_Type(m_CreatureEventAIList[i].Event.event_type);
+        m_EventsByType[next[type]++] = i;
+
+        if (IsTimerBasedEvent(type))
+        {
+            m_TimerEvents.push_back(i);
+        }
+    }
+}
+
 bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pActionInvoker, Creature* pAIEventSender /*=NULL*/)
 {
     if (!pHolder.Enabled || pHolder.Time)
@@ -236,6 +267,9 @@ bool CreatureEventAI::ProcessEvent(CreatureEventAIHolder& pHolder, Unit* pAction
     if (!IsTimerBasedEvent(pHolder.Event.event_type))
     {
         LOG_PROCESS_EVENT;
+
+        // the event may start its repeat timer, which UpdateAI has to count down
+        m_HasEventCooldowns = true;
     }
 
     CreatureEventAI_Event const& event = pHolder.Event;
@@ -1302,20 +1336,23 @@ void CreatureEventAI::JustRespawned()                       // NOTE that this is
 {
     Reset();
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    // Reset generic timer
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_TIMER_GENERIC); itr != EventsEnd(EVENT_T_TIMER_GENERIC); ++itr)
     {
-        // Reset generic timer
-        if (i->Event.event_type == EVENT_T_TIMER_GENERIC)
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[*itr];
+        if (holder.UpdateRepeatTimer(m_creature, holder.Event.timer.initialMin, holder.Event.timer.initialMax))
         {
-            if (i->UpdateRepeatTimer(m_creature, i->Event.timer.initialMin, i->Event.timer.initialMax))
-            {
-                i->Enabled = true;
-            }
+            holder.Enabled = true;
         }
-        // Handle Spawned Events
-        else if (SpawnedEventConditionsCheck((*i).Event))
+    }
+
+    // Handle Spawned Events
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_SPAWNED); itr != EventsEnd(EVENT_T_SPAWNED); ++itr)
+    {
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[*itr];
+        if (SpawnedEventConditionsCheck(holder.Event))
         {
-            ProcessEvent(*i);
+            ProcessEvent(holder);
         }
     }
 }
@@ -1326,38 +1363,23 @@ void CreatureEventAI::Reset()
     m_EventDiff = 0;
     m_throwAIEventStep = 0;
 
-    // Reset all events to enabled
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    // Reset all out of combat timers
+    // TODO: verify if other events previously disabled (ex. aggro yell) should be enabled here, instead of enable them in void Aggro()
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_TIMER_OOC); itr != EventsEnd(EVENT_T_TIMER_OOC); ++itr)
     {
-        CreatureEventAI_Event const& event = i->Event;
-        switch (event.event_type)
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[*itr];
+        if (holder.UpdateRepeatTimer(m_creature, holder.Event.timer.initialMin, holder.Event.timer.initialMax))
         {
-                // Reset all out of combat timers
-            case EVENT_T_TIMER_OOC:
-            {
-                if (i->UpdateRepeatTimer(m_creature, event.timer.initialMin, event.timer.initialMax))
-                {
-                    i->Enabled = true;
-                }
-                break;
-            }
-            default:
-            // TODO: enable below code line / verify this is correct to enable events previously disabled (ex. aggro yell), instead of enable this in void Aggro()
-            //i->Enabled = true;
-            //i->Time = 0;
-            break;
+            holder.Enabled = true;
         }
     }
 }
 
 void CreatureEventAI::JustReachedHome()
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_REACHED_HOME); itr != EventsEnd(EVENT_T_REACHED_HOME); ++itr)
     {
-        if (i->Event.event_type == EVENT_T_REACHED_HOME)
-        {
-            ProcessEvent(*i);
-        }
+        ProcessEvent(m_CreatureEventAIList[*itr]);
     }
 
     Reset();
@@ -1378,12 +1400,9 @@ void CreatureEventAI::EnterEvadeMode()
     m_creature->SetLootRecipient(NULL);
 
     // Handle Evade events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_EVADE); itr != EventsEnd(EVENT_T_EVADE); ++itr)
     {
-        if (i->Event.event_type == EVENT_T_EVADE)
-        {
-            ProcessEvent(*i);
-        }
+        ProcessEvent(m_CreatureEventAIList[*itr]);
     }
 }
 
@@ -1406,12 +1425,9 @@ void CreatureEventAI::JustDied(Unit* killer)
     }
 
     // Handle On Death events
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_DEATH); itr != EventsEnd(EVENT_T_DEATH); ++itr)
     {
-        if (i->Event.event_type == EVENT_T_DEATH)
-        {
-            ProcessEvent(*i, killer);
-        }
+        ProcessEvent(m_CreatureEventAIList[*itr], killer);
     }
 
     // reset phase after any death state events
@@ -1425,45 +1441,33 @@ void CreatureEventAI::KilledUnit(Unit* victim)
         return;
     }
 
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_KILL); itr != EventsEnd(EVENT_T_KILL); ++itr)
     {
-        if (i->Event.event_type == EVENT_T_KILL)
-        {
-            ProcessEvent(*i, victim);
-        }
+        ProcessEvent(m_CreatureEventAIList[*itr], victim);
     }
 }
 
 void CreatureEventAI::JustSummoned(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_SUMMONED_UNIT); itr != EventsEnd(EVENT_T_SUMMONED_UNIT); ++itr)
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_UNIT)
-        {
-            ProcessEvent(*i, pUnit);
-        }
+        ProcessEvent(m_CreatureEventAIList[*itr], pUnit);
     }
 }
 
 void CreatureEventAI::SummonedCreatureJustDied(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_SUMMONED_JUST_DIED); itr != EventsEnd(EVENT_T_SUMMONED_JUST_DIED); ++itr)
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DIED)
-        {
-            ProcessEvent(*i, pUnit);
-        }
+        ProcessEvent(m_CreatureEventAIList[*itr], pUnit);
     }
 }
 
 void CreatureEventAI::SummonedCreatureDespawn(Creature* pUnit)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_SUMMONED_JUST_DESPAWN); itr != EventsEnd(EVENT_T_SUMMONED_JUST_DESPAWN); ++itr)
     {
-        if (i->Event.event_type == EVENT_T_SUMMONED_JUST_DESPAWN)
-        {
-            ProcessEvent(*i, pUnit);
-        }
+        ProcessEvent(m_CreatureEventAIList[*itr], pUnit);
     }
 }
 
@@ -1471,13 +1475,13 @@ void CreatureEventAI::ReceiveAIEvent(AIEventType eventType, Creature* pSender, U
 {
     MANGOS_ASSERT(pSender);
 
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_RECEIVE_AI_EVENT); itr != EventsEnd(EVENT_T_RECEIVE_AI_EVENT); ++itr)
     {
-        if (itr->Event.event_type == EVENT_T_RECEIVE_AI_EVENT &&
-            itr->Event.receiveAIEvent.eventType == eventType && (!itr->Event.receiveAIEvent.senderEntry || itr->Event.receiveAIEvent.senderEntry == pSender->GetEntry()))
-            {
-                ProcessEvent(*itr, pInvoker, pSender);
-            }
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[*itr];
+        if (holder.Event.receiveAIEvent.eventType == eventType && (!holder.Event.receiveAIEvent.senderEntry || holder.Event.receiveAIEvent.senderEntry == pSender->GetEntry()))
+        {
+            ProcessEvent(holder, pInvoker, pSender);
+        }
     }
 }
 
@@ -1537,24 +1541,23 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
     }
 
     // Check for OOC LOS Event
-    if (m_HasOOCLoSEvent && !m_creature->getVictim())
+    if (HasEventType(EVENT_T_OOC_LOS) && !m_creature->getVictim())
     {
-        for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+        for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_OOC_LOS); itr != EventsEnd(EVENT_T_OOC_LOS); ++itr)
         {
-            if (itr->Event.event_type == EVENT_T_OOC_LOS)
-            {
-                // can trigger if closer than fMaxAllowedRange
-                float fMaxAllowedRange = (float)itr->Event.ooc_los.maxRange;
+            CreatureEventAIHolder& holder = m_CreatureEventAIList[*itr];
+
+            // can trigger if closer than fMaxAllowedRange
+            float fMaxAllowedRange = (float)holder.Event.ooc_los.maxRange;
 
-                // if friendly event && who is not hostile OR hostile event && who is hostile
-                if ((itr->Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
-                    ((!itr->Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
+            // if friendly event && who is not hostile OR hostile event && who is hostile
+            if ((holder.Event.ooc_los.noHostile && !m_creature->IsHostileTo(who)) ||
+                ((!holder.Event.ooc_los.noHostile) && m_creature->IsHostileTo(who)))
+            {
+                // if range is ok and we are actually in LOS
+                if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
                 {
-                    // if range is ok and we are actually in LOS
-                    if (m_creature->IsWithinDistInMap(who, fMaxAllowedRange) && m_creature->IsWithinLOSInMap(who))
-                    {
-                        ProcessEvent(*itr, who);
-                    }
+                    ProcessEvent(holder, who);
                 }
             }
         }
@@ -1592,14 +1595,16 @@ void CreatureEventAI::MoveInLineOfSight(Unit* who)
 
 void CreatureEventAI::SpellHit(Unit* pUnit, const SpellEntry* pSpell)
 {
-    for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
-        if (i->Event.event_type == EVENT_T_SPELLHIT)
-            // If spell id matches (or no spell id) & if spell school matches (or no spell school)
-            if (!i->Event.spell_hit.spellId || pSpell->Id == i->Event.spell_hit.spellId)
-                if (pSpell->SchoolMask & i->Event.spell_hit.schoolMask)
-                {
-                    ProcessEvent(*i, pUnit);
-                }
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_SPELLHIT); itr != EventsEnd(EVENT_T_SPELLHIT); ++itr)
+    {
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[*itr];
+        // If spell id matches (or no spell id) & if spell school matches (or no spell school)
+        if (!holder.Event.spell_hit.spellId || pSpell->Id == holder.Event.spell_hit.spellId)
+            if (pSpell->SchoolMask & holder.Event.spell_hit.schoolMask)
+            {
+                ProcessEvent(holder, pUnit);
+            }
+    }
 }
 
 void CreatureEventAI::UpdateAI(const uint32 diff)
@@ -1612,35 +1617,25 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
     {
         m_EventDiff += diff;
 
-        // Check for time based events
-        for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
+        // Check for time based events, other events only need their repeat timers counted down
+        if (m_HasEventCooldowns)
         {
-            // Decrement Timers
-            if (i->Time)
+            m_HasEventCooldowns = false;
+            for (CreatureEventAIList::iterator i = m_CreatureEventAIList.begin(); i != m_CreatureEventAIList.end(); ++i)
             {
-                if (i->Time > m_EventDiff)
-                {
-                    // Do not decrement timers if event cannot trigger in this phase
-                    if (!(i->Event.event_inverse_phase_mask & (1 << m_Phase)))
-                    {
-                        i->Time -= m_EventDiff;
-                    }
-                }
-                else
+                UpdateEventTimer(*i);
+
+                if (i->Time && !IsTimerBasedEvent(EventAI_Type(i->Event.event_type)))
                 {
-                    i->Time = 0;
+                    m_HasEventCooldowns = true;
                 }
             }
-
-            // Skip processing of events that have time remaining or are disabled
-            if (!(i->Enabled) || i->Time)
-            {
-                continue;
-            }
-
-            if (IsTimerBasedEvent(i->Event.event_type))
+        }
+        else
+        {
+            for (EventIndexList::const_iterator itr = m_TimerEvents.begin(); itr != m_TimerEvents.end(); ++itr)
             {
-                ProcessEvent(*i);
+                UpdateEventTimer(m_CreatureEventAIList[*itr]);
             }
         }
 
@@ -1684,6 +1679,37 @@ void CreatureEventAI::UpdateAI(const uint32 diff)
     }
 }
 
+void CreatureEventAI::UpdateEventTimer(CreatureEventAIHolder& holder)
+{
+    // Decrement Timers
+    if (holder.Time)
+    {
+        if (holder.Time > m_EventDiff)
+        {
+            // Do not decrement timers if event cannot trigger in this phase
+            if (!(holder.Event.event_inverse_phase_mask & (1 << m_Phase)))
+            {
+                holder.Time -= m_EventDiff;
+            }
+        }
+        else
+        {
+            holder.Time = 0;
+        }
+    }
+
+    // Skip processing of events that have time remaining or are disabled
+    if (!holder.Enabled || holder.Time)
+    {
+        return;
+    }
+
+    if (IsTimerBasedEvent(EventAI_Type(holder.Event.event_type)))
+    {
+        ProcessEvent(holder);
+    }
+}
+
 bool CreatureEventAI::IsVisible(Unit* pl) const
 {
     return m_creature->IsWithinDist(pl, sWorld.getConfig(CONFIG_FLOAT_SIGHT_MONSTER))
@@ -1827,21 +1853,19 @@ void CreatureEventAI::DoFindFriendlyMissingBuff(std::list<Creature*>& _list, flo
 
 void CreatureEventAI::ReceiveEmote(Player* pPlayer, uint32 text_emote)
 {
-    for (CreatureEventAIList::iterator itr = m_CreatureEventAIList.begin(); itr != m_CreatureEventAIList.end(); ++itr)
+    for (EventIndexList::const_iterator itr = EventsBegin(EVENT_T_RECEIVE_EMOTE); itr != EventsEnd(EVENT_T_RECEIVE_EMOTE); ++itr)
     {
-        if (itr->Event.event_type == EVENT_T_RECEIVE_EMOTE)
+        CreatureEventAIHolder& holder = m_CreatureEventAIList[*itr];
+        if (holder.Event.receive_emote.emoteId != text_emote)
         {
-            if (itr->Event.receive_emote.emoteId != text_emote)
-            {
-                continue;
-            }
+            continue;
+        }
 
-            PlayerCondition pcon(0, itr->Event.receive_emote.condition, itr->Event.receive_emote.conditionValue1, itr->Event.receive_emote.conditionValue2);
-            if (pcon.Meets(pPlayer, m_creature->GetMap(), m_creature, CONDITION_FROM_EVENTAI))
-            {
-                DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
-                ProcessEvent(*itr, pPlayer);
-            }
+        PlayerCondition pcon(0, holder.Event.receive_emote.condition, holder.Event.receive_emote.conditionValue1, holder.Event.receive_emote.conditionValue2);
+        if (pcon.Meets(pPlayer, m_creature->GetMap(), m_creature, CONDITION_FROM_EVENTAI))
+        {
+            DEBUG_FILTER_LOG(LOG_FILTER_AI_AND_MOVEGENSS, "CreatureEventAI: ReceiveEmote CreatureEventAI: Condition ok, processing");
+            ProcessEvent(holder, pPlayer);
         }
     }
 }
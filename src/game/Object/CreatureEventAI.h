@@ -685,10 +685,23 @@ class CreatureEventAI : public CreatureAI
         typedef std::vector<CreatureEventAIHolder> CreatureEventAIList;
         CreatureEventAIList m_CreatureEventAIList;          // Holder for events (stores enabled, time, and eventid)
 
+        // Events grouped by type, so hooks only visit the events they can trigger
+        typedef std::vector<uint16> EventIndexList;
+        EventIndexList m_EventsByType;                      // Indexes into m_CreatureEventAIList, by type and then in list order
+        uint16 m_EventTypeStart[EVENT_T_END + 1];           // Start of each type in m_EventsByType
+        uint32 m_EventTypeMask;                             // Types that have at least one event
+        EventIndexList m_TimerEvents;                       // Timer based events, in list order
+        bool   m_HasEventCooldowns;                         // A not timer based event may have a repeat timer running
+
+        void BuildEventTypeIndex();
+        bool HasEventType(EventAI_Type type) const { return m_EventTypeMask & (1u << type); }
+        EventIndexList::const_iterator EventsBegin(EventAI_Type type) const { return m_EventsByType.begin() + m_EventTypeStart[type]; }
+        EventIndexList::const_iterator EventsEnd(EventAI_Type type) const { return m_EventsByType.begin() + m_EventTypeStart[type + 1]; }
+        void UpdateEventTimer(CreatureEventAIHolder& holder);
+
         uint8  m_Phase;                                     // Current phase, max 32 phases
         bool   m_MeleeEnabled;                              // If we allow melee auto attack
         bool   m_DynamicMovement;                           // Core will control creatures movement if this is enabled
-        bool   m_HasOOCLoSEvent;                            // Cache if a OOC-LoS Event exists
         uint32 m_InvinceabilityHpLevel;                     // Minimal health level allowed at damage apply
 
         uint32 m_throwAIEventMask;                          // Automatically throw AIEvents that are encoded into this mask
@@ -24,6 +24,7 @@
 
 #include "Database/DatabaseEnv.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "WorldSession.h"
 #include "Player.h"
 #include "Opcodes.h"
@@ -757,18 +758,20 @@ void Guild::BroadcastAddonToOfficers(WorldSession* session, const std::string& m
 
 void Guild::BroadcastPacket(WorldPacket* packet)
 {
+    SharedWorldPacket shared(*packet);
     for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
     {
         Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
         if (player)
         {
-            player->GetSession()->SendPacket(packet);
+            player->GetSession()->SendPacket(shared);
         }
     }
 }
 
 void Guild::BroadcastPacketToRank(WorldPacket* packet, uint32 rankId)
 {
+    SharedWorldPacket shared(*packet);
     for (MemberList::const_iterator itr = members.begin(); itr != members.end(); ++itr)
     {
         if (itr->second.RankId == rankId)
@@ -776,7 +779,7 @@ void Guild::BroadcastPacketToRank(WorldPacket* packet, uint32 rankId)
             Player* player = ObjectAccessor::FindPlayer(ObjectGuid(HIGHGUID_PLAYER, itr->first));
             if (player)
             {
-                player->GetSession()->SendPacket(packet);
+                player->GetSession()->SendPacket(shared);
             }
         }
     }
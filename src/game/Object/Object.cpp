@@ -67,6 +67,7 @@ Object::Object(): m_updateFlag(0)
 
     m_inWorld           = false;
     m_objectUpdated     = false;
+    m_clientUpdateIndex = 0;
 }
 
 Object::~Object()
@@ -205,8 +206,40 @@ void Object::SendCreateUpdateToPlayer(Player* player)
     player->GetSession()->SendPacket(&packet);
 }
 
-void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateTemplate* valuesTemplate) const
 {
+    // the object's own player sees more fields, it never shares the template
+    if (valuesTemplate && target != this)
+    {
+        if (!valuesTemplate->built)
+        {
+            valuesTemplate->data << uint8(UPDATETYPE_VALUES);
+            valuesTemplate->data << GetPackGUID();
+
+            UpdateMask updateMask;
+            updateMask.SetCount(m_valuesCount);
+
+            _SetUpdateBits(&updateMask, target);
+            BuildValuesUpdate(UPDATETYPE_VALUES, &valuesTemplate->data, &updateMask, target, &valuesTemplate->patches);
+            valuesTemplate->built = true;
+        }
+
+        if (valuesTemplate->patches.empty())
+        {
+            data->AddUpdateBlock(valuesTemplate->data);
+            return;
+        }
+
+        ByteBuffer buf(valuesTemplate->data);
+        for (ValuesUpdateTemplate::PatchList::const_iterator itr = valuesTemplate->patches.begin(); itr != valuesTemplate->patches.end(); ++itr)
+        {
+            buf.put<uint32>(itr->first, GetViewerUpdateFieldValue(itr->second, target));
+        }
+
+        data->AddUpdateBlock(buf);
+        return;
+    }
+
     ByteBuffer buf(500);
 
     buf << uint8(UPDATETYPE_VALUES);
@@ -559,259 +592,233 @@ void Object::BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const
     }
 }
 
-void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const
+void Object::SetForcedUpdateBits(uint8 updatetype, UpdateMask* updateMask) const
 {
-    if (!target)
+    if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
     {
-        return;
+        updateMask->SetBit(GAMEOBJECT_DYNAMIC);
+
+        if (updatetype == UPDATETYPE_VALUES)
+        {
+            updateMask->SetBit(GAMEOBJECT_BYTES_1);         // why do we need this here?
+        }
     }
+    else if (isType(TYPEMASK_UNIT))
+    {
+        if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
+        {
+            updateMask->SetBit(UNIT_FIELD_AURASTATE);
+        }
+    }
+}
 
-    uint32 valuesCount = m_valuesCount;
-    if(GetTypeId() == TYPEID_PLAYER && target != this)
+bool Object::IsViewerUpdateField(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
     {
-        valuesCount = PLAYER_END_NOT_SELF;
+        switch (index)
+        {
+            case UNIT_NPC_FLAGS:
+            case UNIT_DYNAMIC_FLAGS:
+                return GetTypeId() == TYPEID_UNIT;
+            case UNIT_FIELD_AURASTATE:
+                return ((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE);
+            case UNIT_FIELD_FLAGS:
+                return true;
+            default:
+                return false;
+        }
+    }
+    else if (isType(TYPEMASK_GAMEOBJECT))
+    {
+        return index == GAMEOBJECT_DYNAMIC;
     }
 
-    bool IsActivateToQuest = false;
-    bool IsPerCasterAuraState = false;
+    return false;
+}
 
-    if (updatetype == UPDATETYPE_CREATE_OBJECT || updatetype == UPDATETYPE_CREATE_OBJECT2)
+uint32 Object::GetViewerUpdateFieldValue(uint16 index, Player* target) const
+{
+    if (isType(TYPEMASK_GAMEOBJECT))
     {
-        if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
+        // GAMEOBJECT_DYNAMIC, sent as uint16 flags followed by uint16(-1)
+        // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
+        //      most likely related to "can enter map" and then should be 0 if can not enter
+        GameObject const* go = (GameObject const*)this;
+        if (go->IsTransport() || !(go->ActivateToQuest(target) || target->isGameMaster()))
         {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
-            {
-                IsActivateToQuest = true;
-            }
-
-            updateMask->SetBit(GAMEOBJECT_DYNAMIC);
+            // disable quest object
+            return 0xFFFF0000;
         }
-        else if (isType(TYPEMASK_UNIT))
+
+        switch (go->GetGoType())
         {
-            if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
-            {
-                IsPerCasterAuraState = true;
-                updateMask->SetBit(UNIT_FIELD_AURASTATE);
-            }
+            case GAMEOBJECT_TYPE_QUESTGIVER:
+                // GO also seen with GO_DYNFLAG_LO_SPARKLE explicit, relation/reason unclear (192861)
+                return 0xFFFF0000 | GO_DYNFLAG_LO_ACTIVATE;
+            case GAMEOBJECT_TYPE_CHEST:
+            case GAMEOBJECT_TYPE_GENERIC:
+            case GAMEOBJECT_TYPE_SPELL_FOCUS:
+            case GAMEOBJECT_TYPE_GOOBER:
+                return 0xFFFF0000 | GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE;
+            default:
+                // unknown, not happen.
+                return 0xFFFF0000;
         }
     }
-    else                                                    // case UPDATETYPE_VALUES
+
+    if (index == UNIT_NPC_FLAGS)
     {
-        if (isType(TYPEMASK_GAMEOBJECT) && !((GameObject*)this)->IsTransport())
+        uint32 appendValue = m_uint32Values[index];
+
+        if (!target->canSeeSpellClickOn((Creature*)this))
+        {
+            appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
+        }
+
+        if (appendValue & UNIT_NPC_FLAG_TRAINER)
         {
-            if (((GameObject*)this)->ActivateToQuest(target) || target->isGameMaster())
+            if (!((Creature*)this)->IsTrainerOf(target, false))
             {
-                IsActivateToQuest = true;
+                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
             }
-
-            updateMask->SetBit(GAMEOBJECT_DYNAMIC);
-            updateMask->SetBit(GAMEOBJECT_BYTES_1);         // why do we need this here?
         }
-        else if (isType(TYPEMASK_UNIT))
+
+        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
         {
-            if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE))
+            if (target->getClass() != CLASS_HUNTER)
             {
-                IsPerCasterAuraState = true;
-                updateMask->SetBit(UNIT_FIELD_AURASTATE);
+                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
             }
         }
-    }
 
-    MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
-
-    *data << (uint8)updateMask->GetBlockCount();
-    data->append(updateMask->GetMask(), updateMask->GetLength());
+        return appendValue;
+    }
+    else if (index == UNIT_FIELD_AURASTATE)
+    {
+        // only the caster of the related pet aura sees the conflagrate aura state
+        if (((Unit*)this)->HasAuraState(AURA_STATE_CONFLAGRATE) &&
+            !((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
+        {
+            return m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1));
+        }
 
-    // 2 specialized loops for speed optimization in non-unit case
-    if (isType(TYPEMASK_UNIT))                              // unit (creature/player) case
+        return m_uint32Values[index];
+    }
+    // Gamemasters should be always able to select units - remove not selectable flag
+    else if (index == UNIT_FIELD_FLAGS)
     {
-        for (uint16 index = 0; index < valuesCount; ++index)
+        if (target->isGameMaster())
         {
-            if (updateMask->GetBit(index))
-            {
-                if (index == UNIT_NPC_FLAGS)
-                {
-                    uint32 appendValue = m_uint32Values[index];
+            return m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE;
+        }
 
-                    if (GetTypeId() == TYPEID_UNIT)
-                    {
-                        if (!target->canSeeSpellClickOn((Creature*)this))
-                        {
-                            appendValue &= ~UNIT_NPC_FLAG_SPELLCLICK;
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_TRAINER)
-                        {
-                            if (!((Creature*)this)->IsTrainerOf(target, false))
-                            {
-                                appendValue &= ~(UNIT_NPC_FLAG_TRAINER | UNIT_NPC_FLAG_TRAINER_CLASS | UNIT_NPC_FLAG_TRAINER_PROFESSION);
-                            }
-                        }
-
-                        if (appendValue & UNIT_NPC_FLAG_STABLEMASTER)
-                        {
-                            if (target->getClass() != CLASS_HUNTER)
-                            {
-                                appendValue &= ~UNIT_NPC_FLAG_STABLEMASTER;
-                            }
-                        }
-                    }
+        return m_uint32Values[index];
+    }
 
-                    *data << uint32(appendValue);
-                }
-                else if (index == UNIT_FIELD_AURASTATE)
-                {
-                    if (IsPerCasterAuraState)
-                    {
-                        // IsPerCasterAuraState set if related pet caster aura state set already
-                        if (((Unit*)this)->HasAuraStateForCaster(AURA_STATE_CONFLAGRATE, target->GetObjectGuid()))
-                        {
-                            *data << m_uint32Values[index];
-                        }
-                        else
-                        {
-                            *data << (m_uint32Values[index] & ~(1 << (AURA_STATE_CONFLAGRATE - 1)));
-                        }
-                    }
-                    else
-                    {
-                        *data << m_uint32Values[index];
-                    }
-                }
-                // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-                else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-                {
-                    // convert from float to uint32 and send
-                    *data << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
-                }
+    /* UNIT_DYNAMIC_FLAGS: hide loot animation for players that aren't permitted to loot the corpse */
+    uint32 send_value = m_uint32Values[index];
 
-                // there are some float values which may be negative or can't get negative due to other checks
-                else if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                         (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                         (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
-                {
-                    *data << uint32(m_floatValues[index]);
-                }
+    /* Initiate pointer to creature so we can check loot */
+    Creature* my_creature = (Creature*)this;
 
-                // Gamemasters should be always able to select units - remove not selectable flag
-                else if (index == UNIT_FIELD_FLAGS && target->isGameMaster())
-                {
-                    *data << (m_uint32Values[index] & ~UNIT_FLAG_NOT_SELECTABLE);
-                }
-                /* Hide loot animation for players that aren't permitted to loot the corpse */
-                else if (index == UNIT_DYNAMIC_FLAGS && GetTypeId() == TYPEID_UNIT)
-                {
-                    uint32 send_value = m_uint32Values[index];
-
-                    /* Initiate pointer to creature so we can check loot */
-                    if (Creature* my_creature = (Creature*)this)
-                        /* If the creature is NOT fully looted */
-                        if (!my_creature->loot.isLooted())
-                            /* If the lootable flag is NOT set */
-                            if (!(send_value & UNIT_DYNFLAG_LOOTABLE))
-                            {
-                                /* Update it on the creature */
-                                my_creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
-                                /* Update it in the packet */
-                                send_value = send_value | UNIT_DYNFLAG_LOOTABLE;
-                            }
-
-                    /* If we're not allowed to loot the target, destroy the lootable flag */
-                    if (!target->isAllowedToLoot((Creature*)this))
-                        if (send_value & UNIT_DYNFLAG_LOOTABLE)
-                        {
-                            send_value = send_value & ~UNIT_DYNFLAG_LOOTABLE;
-                        }
-
-                    /* If we are allowed to loot it and mob is tapped by us, destroy the tapped flag */
-                    bool is_tapped = target->IsTappedByMeOrMyGroup((Creature*)this);
-
-                    /* If the creature has tapped flag but is tapped by us, remove the flag */
-                    if (send_value & UNIT_DYNFLAG_TAPPED && is_tapped)
-                    {
-                        send_value = send_value & ~UNIT_DYNFLAG_TAPPED;
-                    }
+    /* If the creature is NOT fully looted */
+    if (!my_creature->loot.isLooted())
+        /* If the lootable flag is NOT set */
+        if (!(send_value & UNIT_DYNFLAG_LOOTABLE))
+        {
+            /* Update it on the creature */
+            my_creature->SetFlag(UNIT_DYNAMIC_FLAGS, UNIT_DYNFLAG_LOOTABLE);
+            /* Update it in the packet */
+            send_value = send_value | UNIT_DYNFLAG_LOOTABLE;
+        }
 
-                    *data << send_value;
-                }
-                else
-                {
-                    // send in current format (float as float, uint32 as uint32)
-                    *data << m_uint32Values[index];
-                }
-            }
+    /* If we're not allowed to loot the target, destroy the lootable flag */
+    if (!target->isAllowedToLoot(my_creature))
+        if (send_value & UNIT_DYNFLAG_LOOTABLE)
+        {
+            send_value = send_value & ~UNIT_DYNFLAG_LOOTABLE;
         }
+
+    /* If we are allowed to loot it and mob is tapped by us, destroy the tapped flag */
+    bool is_tapped = target->IsTappedByMeOrMyGroup(my_creature);
+
+    /* If the creature has tapped flag but is tapped by us, remove the flag */
+    if (send_value & UNIT_DYNFLAG_TAPPED && is_tapped)
+    {
+        send_value = send_value & ~UNIT_DYNFLAG_TAPPED;
     }
-    else if (isType(TYPEMASK_GAMEOBJECT))                   // gameobject case
+
+    return send_value;
+}
+
+uint32 Object::GetSharedUpdateFieldValue(uint16 index) const
+{
+    if (isType(TYPEMASK_UNIT))
     {
-        for (uint16 index = 0; index < valuesCount; ++index)
+        // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+        if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
         {
-            if (updateMask->GetBit(index))
-            {
-                // send in current format (float as float, uint32 as uint32)
-                if (index == GAMEOBJECT_DYNAMIC)
-                {
-                    // GAMEOBJECT_TYPE_DUNGEON_DIFFICULTY can have lo flag = 2
-                    //      most likely related to "can enter map" and then should be 0 if can not enter
+            // convert from float to uint32 and send
+            return uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+        }
 
-                    if (IsActivateToQuest)
-                    {
-                        switch (((GameObject*)this)->GetGoType())
-                        {
-                            case GAMEOBJECT_TYPE_QUESTGIVER:
-                                // GO also seen with GO_DYNFLAG_LO_SPARKLE explicit, relation/reason unclear (192861)
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE);
-                                *data << uint16(-1);
-                                break;
-                            case GAMEOBJECT_TYPE_CHEST:
-                            case GAMEOBJECT_TYPE_GENERIC:
-                            case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                            case GAMEOBJECT_TYPE_GOOBER:
-                                *data << uint16(GO_DYNFLAG_LO_ACTIVATE | GO_DYNFLAG_LO_SPARKLE);
-                                *data << uint16(-1);
-                                break;
-                            default:
-                                // unknown, not happen.
-                                *data << uint16(0);
-                                *data << uint16(-1);
-                                break;
-                        }
-                    }
-                    else
-                    {
-                        // disable quest object
-                        *data << uint16(0);
-                        *data << uint16(-1);
-                    }
-                }
-                else if (index == GAMEOBJECT_BYTES_1)
-                {
-                    if (((GameObject*)this)->GetGOInfo()->type == GAMEOBJECT_TYPE_TRANSPORT)
-                    {
-                        *data << uint32(m_uint32Values[index] | GO_STATE_TRANSPORT_SPEC);
-                    }
-                    else
-                    {
-                        *data << uint32(m_uint32Values[index]);
-                    }
-                }
-                else
-                {
-                    *data << m_uint32Values[index];          // other cases
-                }
-            }
+        // there are some float values which may be negative or can't get negative due to other checks
+        if ((index >= UNIT_FIELD_NEGSTAT0 && index <= UNIT_FIELD_NEGSTAT4) ||
+            (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+            (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+            (index >= UNIT_FIELD_POSSTAT0 && index <= UNIT_FIELD_POSSTAT4))
+        {
+            return uint32(m_floatValues[index]);
         }
     }
-    else                                                    // other objects case (no special index checks)
+    else if (isType(TYPEMASK_GAMEOBJECT))
     {
-        for (uint16 index = 0; index < valuesCount; ++index)
+        if (index == GAMEOBJECT_BYTES_1 && ((GameObject*)this)->GetGOInfo()->type == GAMEOBJECT_TYPE_TRANSPORT)
         {
-            if (updateMask->GetBit(index))
-            {
-                // send in current format (float as float, uint32 as uint32)
-                *data << m_uint32Values[index];
-            }
+            return m_uint32Values[index] | GO_STATE_TRANSPORT_SPEC;
+        }
+    }
+
+    // send in current format (float as float, uint32 as uint32)
+    return m_uint32Values[index];
+}
+
+void Object::BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, ValuesUpdateTemplate::PatchList* patches) const
+{
+    if (!target)
+    {
+        return;
+    }
+
+    uint32 valuesCount = m_valuesCount;
+    if(GetTypeId() == TYPEID_PLAYER && target != this)
+    {
+        valuesCount = PLAYER_END_NOT_SELF;
+    }
+
+    SetForcedUpdateBits(updatetype, updateMask);
+
+    MANGOS_ASSERT(updateMask && updateMask->GetCount() == m_valuesCount);
+
+    *data << (uint8)updateMask->GetBlockCount();
+    data->append(updateMask->GetMask(), updateMask->GetLength());
+
+    for (uint32 index = updateMask->GetNextSetBit(0); index < valuesCount; index = updateMask->GetNextSetBit(index + 1))
+    {
+        if (!IsViewerUpdateField(index))
+        {
+            *data << GetSharedUpdateFieldValue(index);
+        }
+        else if (patches)
+        {
+            // filled in per viewer, see BuildValuesUpdateBlockForPlayer
+            patches->push_back(ValuesUpdateTemplate::PatchList::value_type(uint32(data->wpos()), uint16(index)));
+            *data << uint32(0);
+        }
+        else
+        {
+            *data << GetViewerUpdateFieldValue(index, target);
         }
     }
 }
@@ -1145,7 +1152,7 @@ bool Object::PrintEntryError(char const* descr) const
     return false;
 }
 
-void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players)
+void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateTemplate* valuesTemplate)
 {
     UpdateDataMapType::iterator iter = update_players.find(pl);
 
@@ -1155,8 +1162,13 @@ void Object::BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_play
         MANGOS_ASSERT(p.second);
         iter = p.first;
     }
+    else if (!iter->second.HasData())
+    {
+        // buffer kept from an earlier tick
+        iter->second.SetMapId(pl->GetMapId());
+    }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, valuesTemplate);
 }
 
 void Object::AddToClientUpdateList()
@@ -1700,6 +1712,56 @@ void WorldObject::UpdateAllowedPositionZ(float x, float y, float& z, Map* atMap
     }
 }
 
+// UpdateAllowedPositionZ() for count points. Objects that only follow the ground
+// have the heights of all points looked up in one batch.
+void WorldObject::UpdateAllowedPositionZ(uint32 count, float const* x, float const* y, float* z) const
+{
+    bool canFly = false;
+    bool groundOnly = true;
+    switch (GetTypeId())
+    {
+        case TYPEID_UNIT:
+            canFly = ((Creature const*)this)->CanFly();
+            groundOnly = canFly || !((Creature const*)this)->CanSwim();
+            break;
+        case TYPEID_PLAYER:
+            canFly = ((Player const*)this)->CanFly();
+            groundOnly = canFly;
+            break;
+        default:
+            break;
+    }
+
+    // swimmers need the water level at each point
+    if (!groundOnly || !count)
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            UpdateAllowedPositionZ(x[i], y[i], z[i]);
+        }
+        return;
+    }
+
+    std::vector<float> ground(count);
+    GetMap()->GetHeights(GetPhaseMask(), count, x, y, z, &ground[0]);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (canFly)
+        {
+            // flying units only must not be under the ground
+            if (z[i] < ground[i])
+            {
+                z[i] = ground[i];
+            }
+        }
+        else if (ground[i] > INVALID_HEIGHT)
+        {
+            z[i] = ground[i];
+        }
+    }
+}
+
 bool WorldObject::IsPositionValid() const
 {
     return MaNGOS::IsValidMapCoord(m_position.x, m_position.y, m_position.z, m_position.o);
@@ -2331,6 +2393,7 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    ValuesUpdateTemplate i_valuesTemplate;                  // shared by all viewers but the object itself
     WorldObjectChangeAccumulator(WorldObject& obj, UpdateDataMapType& d) : i_updateDatas(d), i_object(obj)
     {
         // send self fields changes in another way, otherwise
@@ -2348,7 +2411,7 @@ struct WorldObjectChangeAccumulator
             Player* owner = iter->getSource()->GetOwner();
             if (owner != &i_object && owner->HaveAtClient(&i_object))
             {
-                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas);
+                i_object.BuildUpdateDataForPlayer(owner, i_updateDatas, &i_valuesTemplate);
             }
         }
     }
@@ -98,6 +98,24 @@ struct MangosStringLocale;
 
 typedef UNORDERED_MAP<Player*, UpdateData> UpdateDataMapType;
 
+/**
+ * @brief Viewer independent part of a values update.
+ *
+ * Serialized once per object and tick for all viewers but the object itself,
+ * then copied for each viewer with the viewer dependent fields written at the
+ * offsets kept in patches.
+ */
+struct ValuesUpdateTemplate
+{
+    typedef std::vector<std::pair<uint32 /*offset*/, uint16 /*field index*/> > PatchList;
+
+    ValuesUpdateTemplate() : built(false) {}
+
+    bool built;                                             /**< data and patches hold the update */
+    ByteBuffer data;                                        /**< block header, mask and field values */
+    PatchList patches;                                      /**< placeholders for viewer dependent fields */
+};
+
 struct Position
 {
     Position() : x(0.0f), y(0.0f), z(0.0f), o(0.0f) {}
@@ -195,7 +213,11 @@ class Object
         void MarkForClientUpdate();
         void SendForcedObjectUpdate();
 
-        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target, ValuesUpdateTemplate* valuesTemplate = NULL) const;
+        void SetForcedUpdateBits(uint8 updatetype, UpdateMask* updateMask) const;
+        bool IsViewerUpdateField(uint16 index) const;
+        uint32 GetViewerUpdateFieldValue(uint16 index, Player* target) const;
+        uint32 GetSharedUpdateFieldValue(uint16 index) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
 
         virtual void DestroyForPlayer(Player* target, bool anim = false) const;
@@ -445,6 +467,10 @@ class Object
         virtual bool HasInvolvedQuest(uint32 /* quest_id */) const { return false; }
         void SetItsNewObject(bool enable) { m_itsNewObject = enable; }
 
+        // position in the client update list of the map, only meaningful while the object is marked as updated
+        uint32 GetClientUpdateIndex() const { return m_clientUpdateIndex; }
+        void SetClientUpdateIndex(uint32 index) { m_clientUpdateIndex = index; }
+
     protected:
         Object();
 
@@ -456,8 +482,8 @@ class Object
         virtual void _SetCreateBits(UpdateMask* updateMask, Player* target) const;
 
         void BuildMovementUpdate(ByteBuffer* data, uint16 updateFlags) const;
-        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target) const;
-        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players);
+        void BuildValuesUpdate(uint8 updatetype, ByteBuffer* data, UpdateMask* updateMask, Player* target, ValuesUpdateTemplate::PatchList* patches = NULL) const;
+        void BuildUpdateDataForPlayer(Player* pl, UpdateDataMapType& update_players, ValuesUpdateTemplate* valuesTemplate = NULL);
 
         uint16 m_objectType;
 
@@ -476,6 +502,7 @@ class Object
         uint16 m_valuesCount;
 
         bool m_objectUpdated;
+        uint32 m_clientUpdateIndex;
 
     private:
         bool m_inWorld;
@@ -587,6 +614,7 @@ class WorldObject : public Object
         bool IsPositionValid() const;
         void UpdateGroundPositionZ(float x, float y, float& z) const;
         void UpdateAllowedPositionZ(float x, float y, float& z, Map* atMap = NULL) const;
+        void UpdateAllowedPositionZ(uint32 count, float const* x, float const* y, float* z) const;
 
         void GetRandomPoint(float x, float y, float z, float distance, float& rand_x, float& rand_y, float& rand_z, float minDist = 0.0f, float const* ori = NULL) const;
 
@@ -306,6 +306,7 @@ void ObjectAccessor::RemoveOldCorpses()
 
 template <class T> typename HashMapHolder<T>::MapType HashMapHolder<T>::m_objectMap;
 template <class T> ACE_RW_Thread_Mutex HashMapHolder<T>::i_lock;
+template <class T> typename HashMapHolder<T>::Shard HashMapHolder<T>::m_shards[HASHMAP_HOLDER_SHARDS];
 
 /// Global definitions for the hashmap storage
 
@@ -49,6 +49,13 @@ class Unit;
 class WorldObject;
 class Map;
 
+/**
+ * Guid lookups go to one of HASHMAP_HOLDER_SHARDS independently locked shards, so
+ * concurrent Find calls from world, map and network threads rarely share a lock.
+ * The full container behind GetContainer()/GetLock() is kept for iterating all objects.
+ */
+#define HASHMAP_HOLDER_SHARDS 16
+
 template <class T>
 class HashMapHolder
 {
@@ -61,21 +68,34 @@ class HashMapHolder
 
         static void Insert(T* o)
         {
+            {
+                Shard& shard = GetShard(o->GetObjectGuid());
+                WriteGuard guard(shard.lock);
+                shard.objects[o->GetObjectGuid()] = o;
+            }
+
             WriteGuard guard(i_lock);
             m_objectMap[o->GetObjectGuid()] = o;
         }
 
         static void Remove(T* o)
         {
+            {
+                Shard& shard = GetShard(o->GetObjectGuid());
+                WriteGuard guard(shard.lock);
+                shard.objects.erase(o->GetObjectGuid());
+            }
+
             WriteGuard guard(i_lock);
             m_objectMap.erase(o->GetObjectGuid());
         }
 
         static T* Find(ObjectGuid guid)
         {
-            ReadGuard guard(i_lock);
-            typename MapType::iterator itr = m_objectMap.find(guid);
-            return (itr != m_objectMap.end()) ? itr->second : NULL;
+            Shard& shard = GetShard(guid);
+            ReadGuard guard(shard.lock);
+            typename MapType::iterator itr = shard.objects.find(guid);
+            return (itr != shard.objects.end()) ? itr->second : NULL;
         }
 
         static MapType& GetContainer() { return m_objectMap; }
@@ -84,11 +104,24 @@ class HashMapHolder
 
     private:
 
+        struct Shard
+        {
+            LockType lock;
+            MapType  objects;
+        };
+
+        static Shard& GetShard(ObjectGuid guid)
+        {
+            // guid counters are handed out sequentially, so their low bits spread evenly
+            return m_shards[guid.GetRawValue() % HASHMAP_HOLDER_SHARDS];
+        }
+
         // Non instanceable only static
         HashMapHolder() {}
 
         static LockType i_lock;
         static MapType  m_objectMap;
+        static Shard    m_shards[HASHMAP_HOLDER_SHARDS];
 };
 
 class ObjectAccessor : public MaNGOS::Singleton<ObjectAccessor, MaNGOS::ClassLevelLockable<ObjectAccessor, ACE_Thread_Mutex> >
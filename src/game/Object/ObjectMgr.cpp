@@ -505,6 +505,8 @@ struct SQLCreatureLoader : public SQLStorageLoaderBase<SQLCreatureLoader, SQLSto
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    char const* GetSnapshotDependencies() const { return "script_binding"; }
 };
 
 void ObjectMgr::LoadCreatureTemplates()
@@ -2117,6 +2119,8 @@ struct SQLItemLoader : public SQLStorageLoaderBase<SQLItemLoader, SQLStorage>
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    char const* GetSnapshotDependencies() const { return "script_binding"; }
 };
 
 void ObjectMgr::LoadItemPrototypes()
@@ -5292,6 +5296,8 @@ struct SQLInstanceLoader : public SQLStorageLoaderBase<SQLInstanceLoader, SQLSto
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    char const* GetSnapshotDependencies() const { return "script_binding"; }
 };
 
 void ObjectMgr::LoadInstanceTemplate()
@@ -5355,6 +5361,8 @@ struct SQLWorldLoader : public SQLStorageLoaderBase<SQLWorldLoader, SQLStorage>
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    char const* GetSnapshotDependencies() const { return "script_binding"; }
 };
 
 void ObjectMgr::LoadWorldTemplate()
@@ -6634,6 +6642,8 @@ struct SQLGameObjectLoader : public SQLStorageLoaderBase<SQLGameObjectLoader, SQ
     {
         dst = D(sScriptMgr.GetScriptId(src));
     }
+
+    char const* GetSnapshotDependencies() const { return "script_binding"; }
 };
 
 inline void CheckGOLockId(GameObjectInfo const* goInfo, uint32 dataN, uint32 N)
@@ -567,6 +567,7 @@ Player::Player(WorldSession* session): Unit(), m_mover(this), m_camera(this), m_
     m_resetTalentsCost = 0;
     m_resetTalentsTime = 0;
     m_itemUpdateQueueBlocked = false;
+    m_savedAurasValid = false;
 
     for (int i = 0; i < MAX_MOVE_TYPE; ++i)
     {
@@ -20317,25 +20318,28 @@ void Player::_SaveActions()
     }
 }
 
+bool SavedAuraRow::operator==(SavedAuraRow const& r) const
+{
+    for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+    {
+        if (damage[i] != r.damage[i] || periodicTime[i] != r.periodicTime[i])
+        {
+            return false;
+        }
+    }
+
+    return casterGuid == r.casterGuid && itemGuid == r.itemGuid && spellId == r.spellId && stackCount == r.stackCount &&
+           charges == r.charges && maxDuration == r.maxDuration && duration == r.duration && effIndexMask == r.effIndexMask;
+}
+
 void Player::_SaveAuras()
 {
     static SqlStatementID deleteAuras ;
-    static SqlStatementID insertAuras ;
-
-    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM `character_aura` WHERE `guid` = ?");
-    stmt.PExecute(GetGUIDLow());
+    static SqlBatchStatementID insertAuras ;
 
+    SavedAuraRows rows;
     SpellAuraHolderMap const& auraHolders = GetSpellAuraHolderMap();
 
-    if (auraHolders.empty())
-    {
-        return;
-    }
-
-    stmt = CharacterDatabase.CreateStatement(insertAuras, "INSERT INTO `character_aura` (`guid`, `caster_guid`, `item_guid`, `spell`, `stackcount`, `remaincharges`, "
-            "`basepoints0`, `basepoints1`, `basepoints2`, `periodictime0`, `periodictime1`, `periodictime2`, `maxduration`, `remaintime`, `effIndexMask`) "
-            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
-
     for (SpellAuraHolderMap::const_iterator itr = auraHolders.begin(); itr != auraHolders.end(); ++itr)
     {
         SpellAuraHolder* holder = itr->second;
@@ -20346,14 +20350,13 @@ void Player::_SaveAuras()
         if (!holder->IsPassive() && !IsChanneledSpell(holder->GetSpellProto()) &&
                 (trackedType == TRACK_AURA_TYPE_NOT_TRACKED || (trackedType == TRACK_AURA_TYPE_SINGLE_TARGET && selfCastHolder)))
         {
-            int32  damage[MAX_EFFECT_INDEX];
-            uint32 periodicTime[MAX_EFFECT_INDEX];
-            uint32 effIndexMask = 0;
+            SavedAuraRow row;
+            row.effIndexMask = 0;
 
             for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
             {
-                damage[i] = 0;
-                periodicTime[i] = 0;
+                row.damage[i] = 0;
+                row.periodicTime[i] = 0;
 
                 if (Aura* aur = holder->GetAuraByEffectIndex(SpellEffectIndex(i)))
                 {
@@ -20363,40 +20366,69 @@ void Player::_SaveAuras()
                         continue;
                     }
 
-                    damage[i] = aur->GetModifier()->m_amount;
-                    periodicTime[i] = aur->GetModifier()->periodictime;
-                    effIndexMask |= (1 << i);
+                    row.damage[i] = aur->GetModifier()->m_amount;
+                    row.periodicTime[i] = aur->GetModifier()->periodictime;
+                    row.effIndexMask |= (1 << i);
                 }
             }
 
-            if (!effIndexMask)
+            if (!row.effIndexMask)
             {
                 continue;
             }
 
-            stmt.addUInt32(GetGUIDLow());
-            stmt.addUInt64(holder->GetCasterGuid().GetRawValue());
-            stmt.addUInt32(holder->GetCastItemGuid().GetCounter());
-            stmt.addUInt32(holder->GetId());
-            stmt.addUInt32(holder->GetStackAmount());
-            stmt.addUInt8(holder->GetAuraCharges());
+            row.casterGuid = holder->GetCasterGuid().GetRawValue();
+            row.itemGuid = holder->GetCastItemGuid().GetCounter();
+            row.spellId = holder->GetId();
+            row.stackCount = holder->GetStackAmount();
+            row.charges = holder->GetAuraCharges();
+            row.maxDuration = holder->GetAuraMaxDuration();
+            row.duration = holder->GetAuraDuration();
+            rows.push_back(row);
+        }
+    }
 
-            for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-            {
-                stmt.addInt32(damage[i]);
-            }
+    // nothing changed since the last save (only permanent auras, or none at all)
+    if (m_savedAurasValid && rows == m_savedAuras)
+    {
+        return;
+    }
 
-            for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
-            {
-                stmt.addUInt32(periodicTime[i]);
-            }
+    SqlStatement stmt = CharacterDatabase.CreateStatement(deleteAuras, "DELETE FROM `character_aura` WHERE `guid` = ?");
+    stmt.PExecute(GetGUIDLow());
 
-            stmt.addInt32(holder->GetAuraMaxDuration());
-            stmt.addInt32(holder->GetAuraDuration());
-            stmt.addUInt32(effIndexMask);
-            stmt.Execute();
+    SqlBatchStatement insert(CharacterDatabase, insertAuras, "INSERT INTO `character_aura` (`guid`, `caster_guid`, `item_guid`, `spell`, `stackcount`, `remaincharges`, "
+                             "`basepoints0`, `basepoints1`, `basepoints2`, `periodictime0`, `periodictime1`, `periodictime2`, `maxduration`, `remaintime`, `effIndexMask`) VALUES ",
+                             "(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+
+    for (SavedAuraRows::const_iterator itr = rows.begin(); itr != rows.end(); ++itr)
+    {
+        insert.addUInt32(GetGUIDLow());
+        insert.addUInt64(itr->casterGuid);
+        insert.addUInt32(itr->itemGuid);
+        insert.addUInt32(itr->spellId);
+        insert.addUInt32(itr->stackCount);
+        insert.addUInt8(itr->charges);
+
+        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+        {
+            insert.addInt32(itr->damage[i]);
         }
+
+        for (uint32 i = 0; i < MAX_EFFECT_INDEX; ++i)
+        {
+            insert.addUInt32(itr->periodicTime[i]);
+        }
+
+        insert.addInt32(itr->maxDuration);
+        insert.addInt32(itr->duration);
+        insert.addUInt32(itr->effIndexMask);
     }
+
+    insert.Execute();
+
+    m_savedAuras.swap(rows);
+    m_savedAurasValid = true;
 }
 
 void Player::_SaveGlyphs()
@@ -20497,9 +20529,23 @@ void Player::_SaveInventory()
         return;
     }
 
-    static SqlStatementID insertInventory ;
+    static SqlBatchStatementID insertInventory ;
     static SqlStatementID updateInventory ;
-    static SqlStatementID deleteInventory ;
+    static SqlBatchStatementID deleteInventory ;
+
+    // free the slots of removed items before a moved or new item takes one of them
+    SqlBatchStatement stmtDel(CharacterDatabase, deleteInventory, "DELETE FROM `character_inventory` WHERE `item` IN (", "?", ")");
+    for (size_t i = 0; i < m_itemUpdateQueue.size(); ++i)
+    {
+        Item* item = m_itemUpdateQueue[i];
+        if (item && item->GetState() == ITEM_REMOVED)
+        {
+            stmtDel.addUInt32(item->GetGUIDLow());
+        }
+    }
+    stmtDel.Execute();
+
+    SqlBatchStatement stmtIns(CharacterDatabase, insertInventory, "INSERT INTO `character_inventory` (`guid`,`bag`,`slot`,`item`,`item_template`) VALUES ", "(?, ?, ?, ?, ?)");
 
     for (size_t i = 0; i < m_itemUpdateQueue.size(); ++i)
     {
@@ -20512,16 +20558,12 @@ void Player::_SaveInventory()
         switch (item->GetState())
         {
             case ITEM_NEW:
-            {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(insertInventory, "INSERT INTO `character_inventory` (`guid`,`bag`,`slot`,`item`,`item_template`) VALUES (?, ?, ?, ?, ?)");
-                stmt.addUInt32(GetGUIDLow());
-                stmt.addUInt32(bag_guid);
-                stmt.addUInt8(item->GetSlot());
-                stmt.addUInt32(item->GetGUIDLow());
-                stmt.addUInt32(item->GetEntry());
-                stmt.Execute();
-            }
-            break;
+                stmtIns.addUInt32(GetGUIDLow());
+                stmtIns.addUInt32(bag_guid);
+                stmtIns.addUInt8(item->GetSlot());
+                stmtIns.addUInt32(item->GetGUIDLow());
+                stmtIns.addUInt32(item->GetEntry());
+                break;
             case ITEM_CHANGED:
             {
                 SqlStatement stmt = CharacterDatabase.CreateStatement(updateInventory, "UPDATE `character_inventory` SET `guid` = ?, `bag` = ?, `slot` = ?, `item_template` = ? WHERE `item` = ?");
@@ -20533,18 +20575,17 @@ void Player::_SaveInventory()
                 stmt.Execute();
             }
             break;
-            case ITEM_REMOVED:
-            {
-                SqlStatement stmt = CharacterDatabase.CreateStatement(deleteInventory, "DELETE FROM `character_inventory` WHERE `item` = ?");
-                stmt.PExecute(item->GetGUIDLow());
-            }
-            break;
+            case ITEM_REMOVED:                              // inventory row already deleted above
             case ITEM_UNCHANGED:
                 break;
         }
 
         item->SaveToDB();                                   // item have unchanged inventory record and can be save standalone
     }
+
+    // after the updates, so new items may take the slots moved items left
+    stmtIns.Execute();
+
     m_itemUpdateQueue.clear();
 }
 
@@ -20816,11 +20857,13 @@ void Player::_SaveSkills()
 
 void Player::_SaveSpells()
 {
-    static SqlStatementID delSpells ;
-    static SqlStatementID insSpells ;
+    static SqlBatchStatementID delSpells ;
+    static SqlBatchStatementID insSpells ;
 
-    SqlStatement stmtDel = CharacterDatabase.CreateStatement(delSpells, "DELETE FROM `character_spell` WHERE `guid` = ? and `spell` = ?");
-    SqlStatement stmtIns = CharacterDatabase.CreateStatement(insSpells, "INSERT INTO `character_spell` (`guid`,`spell`,`active`,`disabled`) VALUES (?, ?, ?, ?)");
+    SqlBatchStatement stmtDel(CharacterDatabase, delSpells, "DELETE FROM `character_spell` WHERE `guid` = ? AND `spell` IN (", "?", ")");
+    SqlBatchStatement stmtIns(CharacterDatabase, insSpells, "INSERT INTO `character_spell` (`guid`,`spell`,`active`,`disabled`) VALUES ", "(?, ?, ?, ?)");
+
+    stmtDel.addUInt32(GetGUIDLow());
 
     for (PlayerSpellMap::iterator itr = m_spells.begin(), next = m_spells.begin(); itr != m_spells.end();)
     {
@@ -20830,13 +20873,16 @@ void Player::_SaveSpells()
         {
             if (itr->second.state == PLAYERSPELL_REMOVED || itr->second.state == PLAYERSPELL_CHANGED)
             {
-                stmtDel.PExecute(GetGUIDLow(), itr->first);
+                stmtDel.addUInt32(itr->first);
             }
 
             // add only changed/new not dependent spells
             if (!itr->second.dependent && (itr->second.state == PLAYERSPELL_NEW || itr->second.state == PLAYERSPELL_CHANGED))
             {
-                stmtIns.PExecute(GetGUIDLow(), itr->first, uint8(itr->second.active ? 1 : 0), uint8(itr->second.disabled ? 1 : 0));
+                stmtIns.addUInt32(GetGUIDLow());
+                stmtIns.addUInt32(itr->first);
+                stmtIns.addUInt8(itr->second.active ? 1 : 0);
+                stmtIns.addUInt8(itr->second.disabled ? 1 : 0);
             }
         }
 
@@ -20850,6 +20896,10 @@ void Player::_SaveSpells()
             ++itr;
         }
     }
+
+    // changed spells are deleted and inserted again, so all deletes have to be sent first
+    stmtDel.Execute();
+    stmtIns.Execute();
 }
 
 void Player::_SaveTalents()
@@ -136,6 +136,25 @@ struct PlayerSpell
     bool disabled          : 1;                             // first rank has been learned in result talent learn but currently talent unlearned, save max learned ranks
 };
 
+// character_aura row as written by the last Player::_SaveAuras
+struct SavedAuraRow
+{
+    uint64 casterGuid;
+    uint32 itemGuid;
+    uint32 spellId;
+    uint32 stackCount;
+    uint8 charges;
+    int32 damage[MAX_EFFECT_INDEX];
+    uint32 periodicTime[MAX_EFFECT_INDEX];
+    int32 maxDuration;
+    int32 duration;
+    uint32 effIndexMask;
+
+    bool operator==(SavedAuraRow const& r) const;
+};
+
+typedef std::vector<SavedAuraRow> SavedAuraRows;
+
 struct PlayerTalent
 {
     TalentEntry const* talentEntry;
@@ -2775,6 +2794,9 @@ class Player : public Unit
         std::vector<Item*> m_itemUpdateQueue;
         bool m_itemUpdateQueueBlocked;
 
+        SavedAuraRows m_savedAuras;                         // character_aura content written by the last save
+        bool m_savedAurasValid;                             // false until the first save, the DB may hold rows not loaded
+
         uint32 m_ExtraFlags;
         ObjectGuid m_curSelectionGuid;
 
@@ -593,6 +593,65 @@ void GlobalCooldownMgr::CancelGlobalCooldown(SpellEntry const* spellInfo)
     m_GlobalCooldowns[spellInfo->GetStartRecoveryCategory()].duration = 0;
 }
 
+////////////////////////////////////////////////////////////
+// Methods of class ModAuraIndex
+
+ModAuraIndex::AuraList const ModAuraIndex::s_emptyList;
+
+static bool AuraListSlotTypeLess(std::pair<uint16, ModAuraIndex::AuraList*> const& slot, uint16 type)
+{
+    return slot.first < type;
+}
+
+ModAuraIndex::~ModAuraIndex()
+{
+    for (AuraListSlots::iterator itr = m_slots.begin(); itr != m_slots.end(); ++itr)
+    {
+        delete itr->second;
+    }
+}
+
+ModAuraIndex::AuraListSlots::const_iterator ModAuraIndex::FindSlot(AuraType type) const
+{
+    return std::lower_bound(m_slots.begin(), m_slots.end(), uint16(type), AuraListSlotTypeLess);
+}
+
+ModAuraIndex::AuraList const& ModAuraIndex::Get(AuraType type) const
+{
+    if (type >= TOTAL_AURAS || !m_types.test(type))
+    {
+        return s_emptyList;
+    }
+
+    return *FindSlot(type)->second;
+}
+
+ModAuraIndex::AuraList* ModAuraIndex::Find(AuraType type)
+{
+    if (type >= TOTAL_AURAS || !m_types.test(type))
+    {
+        return NULL;
+    }
+
+    return FindSlot(type)->second;
+}
+
+ModAuraIndex::AuraList& ModAuraIndex::Acquire(AuraType type)
+{
+    MANGOS_ASSERT(type < TOTAL_AURAS);
+
+    if (m_types.test(type))
+    {
+        return *FindSlot(type)->second;
+    }
+
+    AuraListSlots::iterator itr = std::lower_bound(m_slots.begin(), m_slots.end(), uint16(type), AuraListSlotTypeLess);
+    AuraList* list = new AuraList();
+    m_slots.insert(itr, AuraListSlot(uint16(type), list));
+    m_types.set(type);
+    return *list;
+}
+
 ////////////////////////////////////////////////////////////
 // Methods of class Unit
 
@@ -965,16 +1024,18 @@ bool Unit::CanReachWithMeleeAttack(Unit const* pVictim, float flat_mod /*= 0.0f*
 
 void Unit::RemoveSpellsCausingAura(AuraType auraType)
 {
-    for (AuraList::const_iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    AuraList const& auras = m_modAuras.Get(auraType);
+    for (AuraList::const_iterator iter = auras.begin(); iter != auras.end();)
     {
         RemoveAurasDueToSpell((*iter)->GetId());
-        iter = m_modAuras[auraType].begin();
+        iter = auras.begin();
     }
 }
 
 void Unit::RemoveSpellsCausingAura(AuraType auraType, SpellAuraHolder* except)
 {
-    for (AuraList::const_iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    AuraList const& auras = m_modAuras.Get(auraType);
+    for (AuraList::const_iterator iter = auras.begin(); iter != auras.end();)
     {
         // skip `except` aura
         if ((*iter)->GetHolder() == except)
@@ -984,18 +1045,19 @@ void Unit::RemoveSpellsCausingAura(AuraType auraType, SpellAuraHolder* except)
         }
 
         RemoveAurasDueToSpell((*iter)->GetId(), except);
-        iter = m_modAuras[auraType].begin();
+        iter = auras.begin();
     }
 }
 
 void Unit::RemoveSpellsCausingAura(AuraType auraType, ObjectGuid casterGuid)
 {
-    for (AuraList::const_iterator iter = m_modAuras[auraType].begin(); iter != m_modAuras[auraType].end();)
+    AuraList const& auras = m_modAuras.Get(auraType);
+    for (AuraList::const_iterator iter = auras.begin(); iter != auras.end();)
     {
         if ((*iter)->GetCasterGuid() == casterGuid)
         {
             RemoveSpellAuraHolder((*iter)->GetHolder());
-            iter = m_modAuras[auraType].begin();
+            iter = auras.begin();
         }
         else
         {
@@ -5278,7 +5340,7 @@ void Unit::AddAuraToModList(Aura* aura)
 {
     if (aura->GetModifier()->m_auraname < TOTAL_AURAS)
     {
-        m_modAuras[aura->GetModifier()->m_auraname].push_back(aura);
+        m_modAuras.Acquire(aura->GetModifier()->m_auraname).push_back(aura);
     }
 }
 
@@ -6046,9 +6108,9 @@ void Unit::RemoveSingleAuraFromSpellAuraHolder(SpellAuraHolder* holder, SpellEff
 void Unit::RemoveAura(Aura* Aur, AuraRemoveMode mode)
 {
     // remove from list before mods removing (prevent cyclic calls, mods added before including to aura list - use reverse order)
-    if (Aur->GetModifier()->m_auraname < TOTAL_AURAS)
+    if (AuraList* auras = m_modAuras.Find(Aur->GetModifier()->m_auraname))
     {
-        m_modAuras[Aur->GetModifier()->m_auraname].remove(Aur);
+        auras->remove(Aur);
     }
 
     // Set remove mode
@@ -10418,12 +10480,14 @@ void Unit::UpdateVisibilityAndView()
     static const AuraType auratypes[] = {SPELL_AURA_BIND_SIGHT, SPELL_AURA_FAR_SIGHT, SPELL_AURA_NONE};
     for (AuraType const* type = &auratypes[0]; *type != SPELL_AURA_NONE; ++type)
     {
-        AuraList& alist = m_modAuras[*type];
-        if (alist.empty())
+        AuraList* auras = m_modAuras.Find(*type);
+        if (!auras || auras->empty())
         {
             continue;
         }
 
+        AuraList& alist = *auras;
+
         for (AuraList::iterator it = alist.begin(); it != alist.end();)
         {
             Aura* aura = (*it);
@@ -12267,14 +12331,13 @@ void Unit::ApplyMaxPowerMod(Powers power, uint32 val, bool apply)
 
 void Unit::ApplyAuraProcTriggerDamage(Aura* aura, bool apply)
 {
-    AuraList& tAuraProcTriggerDamage = m_modAuras[SPELL_AURA_PROC_TRIGGER_DAMAGE];
     if (apply)
     {
-        tAuraProcTriggerDamage.push_back(aura);
+        m_modAuras.Acquire(SPELL_AURA_PROC_TRIGGER_DAMAGE).push_back(aura);
     }
-    else
+    else if (AuraList* tAuraProcTriggerDamage = m_modAuras.Find(SPELL_AURA_PROC_TRIGGER_DAMAGE))
     {
-        tAuraProcTriggerDamage.remove(aura);
+        tAuraProcTriggerDamage->remove(aura);
     }
 }
 
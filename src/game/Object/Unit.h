@@ -48,6 +48,8 @@
 #include "Timer.h"
 #include "Log.h"
 #include <list>
+#include <vector>
+#include <bitset>
 
 enum SpellInterruptFlags
 {
@@ -1093,6 +1095,52 @@ class GlobalCooldownMgr                                     // Shared by Player
         GlobalCooldownList m_GlobalCooldowns;
 };
 
+/**
+ * Per \ref Unit index of the applied \ref Aura s by \ref AuraType.
+ *
+ * A unit only ever carries a handful of the \ref TOTAL_AURAS aura types, so
+ * instead of one list per type the index keeps a bitset of the types seen and
+ * a small vector, sorted by type, holding a list for each of them. A list is
+ * created on first use and kept until the unit is destroyed, so references and
+ * iterators taken from it stay valid while auras are added and removed.
+ */
+class ModAuraIndex
+{
+    public:
+        typedef std::list<Aura*> AuraList;
+
+        ModAuraIndex() {}
+        ~ModAuraIndex();
+
+        /**
+         * Returns the auras of the given type, or an empty list if the
+         * unit never had one.
+         */
+        AuraList const& Get(AuraType type) const;
+        /**
+         * Returns the auras of the given type, or NULL if the unit never had one.
+         */
+        AuraList* Find(AuraType type);
+        /**
+         * Returns the auras of the given type, creating the list if needed.
+         */
+        AuraList& Acquire(AuraType type);
+
+    private:
+        ModAuraIndex(ModAuraIndex const&);
+        ModAuraIndex& operator=(ModAuraIndex const&);
+
+        typedef std::pair<uint16 /*AuraType*/, AuraList*> AuraListSlot;
+        typedef std::vector<AuraListSlot> AuraListSlots;
+
+        AuraListSlots::const_iterator FindSlot(AuraType type) const;
+
+        std::bitset<TOTAL_AURAS> m_types;                   /**< types that have a list in m_slots */
+        AuraListSlots m_slots;                              /**< lists sorted by aura type */
+
+        static AuraList const s_emptyList;                  /**< returned for types without a list */
+};
+
 enum ActiveStates
 {
     ACT_PASSIVE  = 0x01,                                    // 0x01 - passive
@@ -3342,7 +3390,7 @@ class  Unit : public WorldObject
          * @return A list of the auras currently applied to the \ref Unit with the given \ref AuraType
          * \see Unit::m_modAuras
          */
-        AuraList const& GetAurasByType(AuraType type) const { return m_modAuras[type]; }
+        AuraList const& GetAurasByType(AuraType type) const { return m_modAuras.Get(type); }
         void ApplyAuraProcTriggerDamage(Aura* aura, bool apply);
 
         int32 GetTotalAuraModifier(AuraType auratype) const;
@@ -3593,7 +3641,7 @@ class  Unit : public WorldObject
         bool m_isSorted;
         uint32 m_transform;
 
-        AuraList m_modAuras[TOTAL_AURAS];
+        ModAuraIndex m_modAuras;
         float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
         float m_weaponDamage[MAX_ATTACK][2];
         bool m_canModifyStats;
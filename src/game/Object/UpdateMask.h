@@ -27,6 +27,7 @@
 
 #include "UpdateFields.h"
 #include "Errors.h"
+#include "Utilities/ByteConverter.h"
 
 class UpdateMask
 {
@@ -54,6 +55,35 @@ class UpdateMask
             return (((uint8*)mUpdateMask)[ index >> 3 ] & (1 << (index & 0x7))) != 0;
         }
 
+        /**
+         * @brief Returns the first set bit at or after index, or GetCount() if there is none.
+         *
+         * The mask is scanned a 32 bit block at a time, so walking a sparse mask
+         * costs one test per block instead of one per field.
+         */
+        uint32 GetNextSetBit(uint32 index) const
+        {
+            uint32 block = index >> 5;
+            if (block >= mBlocks)
+            {
+                return mCount;
+            }
+
+            uint32 bits = GetBlock(block) & (~uint32(0) << (index & 0x1F));
+            while (!bits)
+            {
+                if (++block >= mBlocks)
+                {
+                    return mCount;
+                }
+
+                bits = GetBlock(block);
+            }
+
+            uint32 next = (block << 5) + LowestBit(bits);
+            return next < mCount ? next : mCount;
+        }
+
         uint32 GetBlockCount() const { return mBlocks; }
         uint32 GetLength() const { return mBlocks << 2; }
         uint32 GetCount() const { return mCount; }
@@ -127,6 +157,29 @@ class UpdateMask
         }
 
     private:
+        // bits are set per byte in client order, read a block back in the same order
+        uint32 GetBlock(uint32 block) const
+        {
+            uint32 bits = mUpdateMask[block];
+            EndianConvert(bits);
+            return bits;
+        }
+
+        static uint32 LowestBit(uint32 bits)
+        {
+#if defined(__GNUC__)
+            return __builtin_ctz(bits);
+#else
+            uint32 index = 0;
+            while (!(bits & 1))
+            {
+                bits >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
         uint32 mCount;
         uint32 mBlocks;
         uint32* mUpdateMask;
@@ -248,24 +248,38 @@ void ThreatContainer::clearReferences()
         delete(*i);
     }
     iThreatList.clear();
+    iThreatIndex.clear();
 }
 
 //============================================================
-// Return the HostileReference of NULL, if not found
-HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
+
+void ThreatContainer::addReference(HostileReference* pHostileReference)
 {
-    HostileReference* result = NULL;
-    ObjectGuid guid = pVictim->GetObjectGuid();
-    for (ThreatList::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
+    pHostileReference->iListPosition = iThreatList.insert(iThreatList.end(), pHostileReference);
+    iThreatIndex[pHostileReference->getUnitGuid()] = pHostileReference;
+}
+
+//============================================================
+// Remove the reference in constant time, if it is held by this container
+
+void ThreatContainer::remove(HostileReference* pRef)
+{
+    ThreatIndex::iterator itr = iThreatIndex.find(pRef->getUnitGuid());
+    if (itr == iThreatIndex.end() || itr->second != pRef)
     {
-        if ((*i)->getUnitGuid() == guid)
-        {
-            result = (*i);
-            break;
-        }
+        return;
     }
 
-    return result;
+    iThreatIndex.erase(itr);
+    iThreatList.erase(pRef->iListPosition);
+}
+
+//============================================================
+// Return the HostileReference of NULL, if not found
+HostileReference* ThreatContainer::getReferenceByTarget(Unit* pVictim)
+{
+    ThreatIndex::const_iterator itr = iThreatIndex.find(pVictim->GetObjectGuid());
+    return itr != iThreatIndex.end() ? itr->second : NULL;
 }
 
 //============================================================
@@ -303,18 +317,45 @@ void ThreatContainer::modifyThreatPercent(Unit* pVictim, int32 pPercent)
 
 bool HostileReferenceSortPredicate(const HostileReference* lhs, const HostileReference* rhs)
 {
-    // std::list::sort ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
+    // ordering predicate must be: (Pred(x,y)&&Pred(y,x))==false
     return lhs->getThreat() > rhs->getThreat();             // reverse sorting
 }
 
 //============================================================
-// Check if the list is dirty and sort if necessary
+// Check if the list is dirty and restore the order if necessary
+// Between two updates only a few references change their threat, so the list is nearly sorted:
+// splice every out of order reference back to its place instead of sorting the whole list.
+// Splicing keeps the order stable and does not invalidate the stored list positions.
 
 void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
     {
-        iThreatList.sort(HostileReferenceSortPredicate);
+        ThreatList::iterator itr = iThreatList.begin();
+        ++itr;
+        while (itr != iThreatList.end())
+        {
+            ThreatList::iterator next = itr;
+            ++next;
+
+            ThreatList::iterator pos = itr;
+            while (pos != iThreatList.begin())
+            {
+                ThreatList::iterator prev = pos;
+                --prev;
+                if (!HostileReferenceSortPredicate(*itr, *prev))
+                {
+                    break;
+                }
+                pos = prev;
+            }
+
+            if (pos != itr)
+            {
+                iThreatList.splice(pos, iThreatList, itr);
+            }
+            itr = next;
+        }
     }
     iDirty = false;
 }
@@ -649,9 +690,10 @@ void ThreatManager::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStat
                 {
                     setDirty(true);
                 }
+                // remove before adding, the reference only keeps its position in one container
+                iThreatOfflineContainer.remove(hostileReference);
                 iThreatContainer.addReference(hostileReference);
                 iUpdateNeed = true;
-                iThreatOfflineContainer.remove(hostileReference);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
@@ -38,8 +38,11 @@
 class Unit;
 class Creature;
 class ThreatManager;
+class HostileReference;
 struct SpellEntry;
 
+typedef std::list<HostileReference*> ThreatList;
+
 #define THREAT_UPDATE_INTERVAL (1 * IN_MILLISECONDS)        // Server should send threat update to client periodically each second
 
 //==============================================================
@@ -135,25 +138,29 @@ class HostileReference : public Reference<Unit, ThreatManager>
         ObjectGuid iUnitGuid;
         bool iOnline;
         bool iAccessible;
+
+        friend class ThreatContainer;
+        ThreatList::iterator iListPosition;                 // position in the ThreatContainer holding this reference
 };
 
 //==============================================================
 class ThreatManager;
 
-typedef std::list<HostileReference*> ThreatList;
-
 class ThreatContainer
 {
     private:
+        typedef UNORDERED_MAP<ObjectGuid, HostileReference*> ThreatIndex;
+
         ThreatList iThreatList;
+        ThreatIndex iThreatIndex;                           // references by target guid, for lookups without walking the list
         bool iDirty;
     protected:
         friend class ThreatManager;
 
-        void remove(HostileReference* pRef) { iThreatList.remove(pRef); }
-        void addReference(HostileReference* pHostileReference) { iThreatList.push_back(pHostileReference); }
+        void remove(HostileReference* pRef);
+        void addReference(HostileReference* pHostileReference);
         void clearReferences();
-        // Sort the list if necessary
+        // Restore the order of the list if necessary
         void update();
     public:
         ThreatContainer() { iDirty = false; }
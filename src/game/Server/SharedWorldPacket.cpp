@@ -0,0 +1,72 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2021 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/** \file
+    \ingroup u2w
+*/
+
+#include "SharedWorldPacket.h"
+#include "WorldPacket.h"
+
+#include <ace/Message_Block.h>
+#include <ace/Lock_Adapter_T.h>
+#include <ace/Thread_Mutex.h>
+
+/// Duplicates are released by the network threads the sockets belong to,
+/// so the reference count of the payload has to be locked.
+static ACE_Lock_Adapter<ACE_Thread_Mutex> s_PayloadLock;
+
+SharedWorldPacket::SharedWorldPacket(const WorldPacket& pct) : m_Packet(pct), m_Payload(NULL)
+{
+}
+
+SharedWorldPacket::~SharedWorldPacket()
+{
+    if (m_Payload)
+    {
+        m_Payload->release();
+    }
+}
+
+ACE_Message_Block* SharedWorldPacket::DuplicatePayload() const
+{
+    if (m_Packet.empty())
+    {
+        return NULL;
+    }
+
+    if (!m_Payload)
+    {
+        ACE_NEW_RETURN(m_Payload, ACE_Message_Block(m_Packet.size(), ACE_Message_Block::MB_DATA, NULL, NULL, NULL, &s_PayloadLock), NULL);
+
+        if (m_Payload->copy((const char*)m_Packet.contents(), m_Packet.size()) == -1)
+        {
+            m_Payload->release();
+            m_Payload = NULL;
+            return NULL;
+        }
+    }
+
+    return m_Payload->duplicate();
+}
@@ -0,0 +1,66 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2021 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/** \addtogroup u2w User to World Communication
+ *  @{
+ *  \file SharedWorldPacket.h
+ */
+
+#ifndef MANGOS_H_SHAREDWORLDPACKET
+#define MANGOS_H_SHAREDWORLDPACKET
+
+#include "Common.h"
+
+class ACE_Message_Block;
+class WorldPacket;
+
+/// A packet sent unchanged to many sessions.
+/// Sockets that have to queue the packet share one reference counted copy
+/// of its payload, only the encrypted header is written for each of them.
+/// The payload is copied on first use, so the packet must not be modified
+/// while it is being sent.
+class SharedWorldPacket
+{
+    public:
+        explicit SharedWorldPacket(const WorldPacket& pct);
+        ~SharedWorldPacket();
+
+        const WorldPacket& GetPacket() const { return m_Packet; }
+
+        /// Get a new reference to the payload, to be released by the caller.
+        /// @return NULL if the packet has no payload or on allocation failure
+        ACE_Message_Block* DuplicatePayload() const;
+
+    private:
+        SharedWorldPacket(const SharedWorldPacket&);
+        SharedWorldPacket& operator=(const SharedWorldPacket&);
+
+        const WorldPacket& m_Packet;
+
+        /// Payload shared by all sockets, built the first time one needs it
+        mutable ACE_Message_Block* m_Payload;
+};
+
+#endif
+/// @}
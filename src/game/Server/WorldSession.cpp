@@ -32,6 +32,7 @@
 #include "Log.h"
 #include "Opcodes.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "WorldSession.h"
 #include "Player.h"
 #include "ObjectMgr.h"
@@ -165,7 +166,7 @@ char const* WorldSession::GetPlayerName() const
 }
 
 /// Send a packet to the client
-void WorldSession::SendPacket(WorldPacket const* packet)
+void WorldSession::SendPacket(WorldPacket const* packet, SharedWorldPacket const* shared /*= NULL*/)
 {
 #ifdef ENABLE_PLAYERBOTS
     if (GetPlayer()) {
@@ -229,12 +230,17 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
 #endif                                                  // !MANGOS_DEBUG
 
-    if (m_Socket->SendPacket(*packet) == -1)
+    if (m_Socket->SendPacket(*packet, shared) == -1)
     {
         m_Socket->CloseSocket();
     }
 }
 
+void WorldSession::SendPacket(SharedWorldPacket const& packet)
+{
+    SendPacket(&packet.GetPacket(), &packet);
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -45,6 +45,7 @@ struct AuctionHouseEntry;
 struct DeclinedName;
 
 class ObjectGuid;
+class AuctionHouseObject;
 class Creature;
 class Item;
 class Object;
@@ -52,6 +53,7 @@ class Player;
 class Unit;
 class Warden;
 class WorldPacket;
+class SharedWorldPacket;
 class WorldSocket;
 class QueryResult;
 class LoginQueryHolder;
@@ -255,7 +257,9 @@ class WorldSession
         void ReadAddonsInfo(ByteBuffer &data);
         void SendAddonsInfo();
 
-        void SendPacket(WorldPacket const* packet);
+        void SendPacket(WorldPacket const* packet, SharedWorldPacket const* shared = NULL);
+        /// Send a packet that also goes to other sessions, see SharedWorldPacket
+        void SendPacket(SharedWorldPacket const& packet);
         void SendNotification(const char* format, ...) ATTR_PRINTF(2, 3);
         void SendNotification(int32 string_id, ...);
         void SendPetNameInvalid(uint32 error, const std::string& name, DeclinedName* declinedName);
@@ -416,7 +420,7 @@ class WorldSession
         void SendAuctionRemovedNotification(AuctionEntry* auction);
         static void SendAuctionOutbiddedMail(AuctionEntry* auction);
         void SendAuctionCancelledToBidderMail(AuctionEntry* auction);
-        void BuildListAuctionItems(std::vector<AuctionEntry*> const& auctions, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
+        void BuildListAuctionItems(AuctionHouseObject* auctionHouse, uint8* sort, WorldPacket& data, std::wstring const& searchedname, uint32 listfrom, uint32 levelmin,
                                    uint32 levelmax, uint32 usable, uint32 inventoryType, uint32 itemClass, uint32 itemSubClass, uint32 quality, uint32& count, uint32& totalcount, bool isFull);
 
         AuctionHouseEntry const* GetCheckedAuctionHouseForAuctioneer(ObjectGuid guid);
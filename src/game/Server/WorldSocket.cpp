@@ -29,6 +29,8 @@
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
 #include <ace/os_include/sys/os_socket.h>
+#include <ace/os_include/sys/os_uio.h>
+#include <ace/OS_NS_sys_socket.h>
 #include <ace/OS_NS_string.h>
 #include <ace/Reactor.h>
 #include <ace/Auto_Ptr.h>
@@ -39,6 +41,7 @@
 #include "Util.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "SharedDefines.h"
 #include "ByteBuffer.h"
 #include "Opcodes.h"
@@ -169,7 +172,7 @@ const std::string& WorldSocket::GetRemoteAddress(void) const
     return m_Address;
 }
 
-int WorldSocket::SendPacket(const WorldPacket& pct)
+int WorldSocket::SendPacket(const WorldPacket& pct, const SharedWorldPacket* shared /*= NULL*/)
 {
     ACE_GUARD_RETURN(LockType, Guard, m_OutBufferLock, -1);
 
@@ -203,6 +206,34 @@ int WorldSocket::SendPacket(const WorldPacket& pct)
                 MANGOS_ASSERT(false);
             }
     }
+    else if (shared && !pct.empty())
+    {
+        // Enqueue the header, followed by the payload all the other sockets share.
+        ACE_Message_Block* payload = shared->DuplicatePayload();
+        if (!payload)
+        {
+            return -1;
+        }
+
+        ACE_Message_Block* mb;
+
+        ACE_NEW_NORETURN(mb, ACE_Message_Block(header.getHeaderLength()));
+        if (!mb)
+        {
+            payload->release();
+            return -1;
+        }
+
+        mb->copy((char*) header.header, header.getHeaderLength());
+        mb->cont(payload);
+
+        if (msg_queue()->enqueue_tail(mb, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+        {
+            sLog.outError("WorldSocket::SendPacket enqueue_tail");
+            mb->release();
+            return -1;
+        }
+    }
     else
     {
         // Enqueue the packet.
@@ -375,17 +406,52 @@ int WorldSocket::handle_output(ACE_HANDLE)
         return -1;
     }
 
-    const size_t send_len = m_OutBuffer->length();
+    // Gather the output buffer and the queued packets behind it, so they
+    // go out with a single system call and without being copied together.
+    iovec iov[OUTPUT_IOV_COUNT];
+    int iov_count = 0;
+    size_t send_len = 0;
+
+    if (m_OutBuffer->length() > 0)
+    {
+        iov[iov_count].iov_base = m_OutBuffer->rd_ptr();
+        iov[iov_count].iov_len = m_OutBuffer->length();
+        send_len += m_OutBuffer->length();
+        ++iov_count;
+    }
+
+    // shared packets are a header block continued by the shared payload
+    ACE_Message_Block* mblk = NULL;
+    for (ACE_Message_Queue_Iterator<ACE_NULL_SYNCH> itr(*msg_queue()); iov_count < OUTPUT_IOV_COUNT && itr.next(mblk); itr.advance())
+    {
+        for (ACE_Message_Block* part = mblk; part && iov_count < OUTPUT_IOV_COUNT; part = part->cont())
+        {
+            if (part->length() == 0)
+            {
+                continue;
+            }
+
+            iov[iov_count].iov_base = part->rd_ptr();
+            iov[iov_count].iov_len = part->length();
+            send_len += part->length();
+            ++iov_count;
+        }
+    }
 
     if (send_len == 0)
     {
-        return handle_output_queue(Guard);
+        return cancel_wakeup_output(Guard);
     }
 
+    msghdr msg;
+    ACE_OS::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov_count;
+
 #ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len, MSG_NOSIGNAL);
+    ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, MSG_NOSIGNAL);
 #else
-    ssize_t n = peer().send(m_OutBuffer->rd_ptr(), send_len);
+    ssize_t n = ACE_OS::sendmsg(get_handle(), &msg, 0);
 #endif // MSG_NOSIGNAL
 
     if (n == 0)
@@ -401,86 +467,65 @@ int WorldSocket::handle_output(ACE_HANDLE)
 
         return -1;
     }
-    else if (n < (ssize_t)send_len) // now n > 0
-    {
-        m_OutBuffer->rd_ptr(static_cast<size_t>(n));
 
-        // move the data to the base of the buffer
-        m_OutBuffer->crunch();
+    // Release what was sent, the output buffer always holds the oldest data
+    size_t sent = static_cast<size_t>(n);
 
-        return schedule_wakeup_output(Guard);
-    }
-    else // now n == send_len
+    if (m_OutBuffer->length() > 0)
     {
-        m_OutBuffer->reset();
+        if (sent < m_OutBuffer->length())
+        {
+            m_OutBuffer->rd_ptr(sent);
 
-        return handle_output_queue(Guard);
-    }
+            // move the data to the base of the buffer
+            m_OutBuffer->crunch();
 
-    ACE_NOTREACHED(return 0);
-}
+            return schedule_wakeup_output(Guard);
+        }
 
-int WorldSocket::handle_output_queue(GuardType& g)
-{
-    if (msg_queue()->is_empty())
-    {
-        return cancel_wakeup_output(g);
+        sent -= m_OutBuffer->length();
+        m_OutBuffer->reset();
     }
 
-    ACE_Message_Block* mblk;
-
-    if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+    while (sent > 0)
     {
-        sLog.outError("WorldSocket::handle_output_queue dequeue_head");
-        return -1;
-    }
-
-    const size_t send_len = mblk->length();
+        if (msg_queue()->dequeue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+        {
+            sLog.outError("WorldSocket::handle_output dequeue_head");
+            return -1;
+        }
 
-#ifdef MSG_NOSIGNAL
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len, MSG_NOSIGNAL);
-#else
-    ssize_t n = peer().send(mblk->rd_ptr(), send_len);
-#endif // MSG_NOSIGNAL
+        if (sent < mblk->total_length())
+        {
+            // skip the part that was sent, it may end inside a shared payload
+            for (ACE_Message_Block* part = mblk; sent > 0; part = part->cont())
+            {
+                size_t len = std::min(sent, part->length());
+                part->rd_ptr(len);
+                sent -= len;
+            }
 
-    if (n == 0)
-    {
-        mblk->release();
+            if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*)&ACE_Time_Value::zero) == -1)
+            {
+                sLog.outError("WorldSocket::handle_output enqueue_head");
+                mblk->release();
+                return -1;
+            }
 
-        return -1;
-    }
-    else if (n == -1)
-    {
-        if (errno == EWOULDBLOCK || errno == EAGAIN)
-        {
-            msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero);
-            return schedule_wakeup_output(g);
+            return schedule_wakeup_output(Guard);
         }
 
+        sent -= mblk->total_length();
         mblk->release();
-        return -1;
     }
-    else if (n < (ssize_t)send_len) // now n > 0
-    {
-        mblk->rd_ptr(static_cast<size_t>(n));
-
-        if (msg_queue()->enqueue_head(mblk, (ACE_Time_Value*) &ACE_Time_Value::zero) == -1)
-        {
-            sLog.outError("WorldSocket::handle_output_queue enqueue_head");
-            mblk->release();
-            return -1;
-        }
 
-        return schedule_wakeup_output(g);
-    }
-    else // now n == send_len
+    if (n < (ssize_t)send_len)
     {
-        mblk->release();
-
-        return msg_queue()->is_empty() ? cancel_wakeup_output(g) : ACE_Event_Handler::WRITE_MASK;
+        return schedule_wakeup_output(Guard);
     }
 
-    ACE_NOTREACHED(return -1);
+    // more packets were queued than fit in one call
+    return msg_queue()->is_empty() ? cancel_wakeup_output(Guard) : ACE_Event_Handler::WRITE_MASK;
 }
 
 int WorldSocket::handle_close(ACE_HANDLE h, ACE_Reactor_Mask)
@@ -52,6 +52,7 @@
 
 class ACE_Message_Block;
 class WorldPacket;
+class SharedWorldPacket;
 class WorldSession;
 class WorldSocket;
 
@@ -78,6 +79,8 @@ typedef ACE_Acceptor< WorldSocket, ACE_SOCK_ACCEPTOR > WorldAcceptor;
  * uses 200ms celling. As result overhead generated by
  * sending packets from "producer" threads is minimal,
  * and doing a lot of writes with small size is tolerated.
+ * When the socket is flushed, the buffer and the queued packets
+ * are handed to the kernel together in one gathered send.
  *
  * The calls to Update () method are managed by WorldSocketMgr
  * and ReactorRunnable.
@@ -101,6 +104,7 @@ class WorldSocket : protected WorldHandler
         /// Declare some friends
         friend class ACE_Acceptor< WorldSocket, ACE_SOCK_ACCEPTOR >;
         friend class WorldSocketMgr;
+        friend class ReactorRunnable;
 
         /// Mutex type used for various synchronizations.
         typedef ACE_Thread_Mutex LockType;
@@ -117,8 +121,9 @@ class WorldSocket : protected WorldHandler
 
         /// Send A packet on the socket, this function is reentrant.
         /// @param pct packet to send
+        /// @param shared set when pct goes to many sockets, a queued packet then references its payload instead of copying it
         /// @return -1 of failure
-        int SendPacket(const WorldPacket& pct);
+        int SendPacket(const WorldPacket& pct, const SharedWorldPacket* shared = NULL);
 
         /// Add reference to this object.
         long AddReference(void);
@@ -166,9 +171,6 @@ class WorldSocket : protected WorldHandler
         int cancel_wakeup_output(GuardType& g);
         int schedule_wakeup_output(GuardType& g);
 
-        /// Drain the queue if its not empty.
-        int handle_output_queue(GuardType& g);
-
         /// process one incoming packet.
         /// @param new_pct received packet ,note that you need to delete it.
         int ProcessIncoming(WorldPacket* new_pct);
@@ -218,6 +220,9 @@ class WorldSocket : protected WorldHandler
         /// Size of the m_OutBuffer.
         size_t m_OutBufferSize;
 
+        /// Maximum number of blocks handed to one gathered send.
+        static const int OUTPUT_IOV_COUNT = ACE_IOV_MAX < 64 ? ACE_IOV_MAX : 64;
+
         /// True if the socket is registered with the reactor for output
         bool m_OutActive;
 
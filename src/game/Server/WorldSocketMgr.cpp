@@ -34,7 +34,10 @@
 #include "WorldSocketMgr.h"
 
 #include <ace/ACE.h>
+#include <ace/Atomic_Op.h>
+#include <ace/Dev_Poll_Reactor.h>
 #include <ace/TP_Reactor.h>
+#include <ace/Task.h>
 #include <ace/os_include/arpa/os_inet.h>
 #include <ace/os_include/netinet/os_tcp.h>
 #include <ace/os_include/sys/os_types.h>
@@ -42,59 +45,185 @@
 
 #include <set>
 
-WorldSocketMgr::WorldSocketMgr()
-  : m_SockOutKBuff(-1), m_SockOutUBuff(65536), m_UseNoDelay(true),
-    acceptor_(NULL),reactor_(NULL),
-    sockets_()
+/**
+ * This is a helper class to WorldSocketMgr, that manages
+ * network threads, and assigning connections from acceptor thread
+ * to other network threads
+ */
+class ReactorRunnable : protected ACE_Task_Base
 {
-    InitializeOpcodes();
-}
+    public:
 
-WorldSocketMgr::~WorldSocketMgr()
-{
-    if (reactor_) delete reactor_;
-    {
-        if (acceptor_) delete acceptor_;
-    }
-}
+        ReactorRunnable() :
+            m_Reactor(0),
+            m_Connections(0),
+            m_ThreadId(-1)
+        {
+            ACE_Reactor_Impl* imp = 0;
 
+#if defined (ACE_HAS_EVENT_POLL) || defined (ACE_HAS_DEV_POLL)
+            imp = new ACE_Dev_Poll_Reactor();
 
-int WorldSocketMgr::svc()
-{
-    DEBUG_LOG("Starting Network Thread");
+            imp->max_notify_iterations(128);
+            imp->restart(1);
+#else
+            imp = new ACE_TP_Reactor();
+            imp->max_notify_iterations(128);
+#endif
 
-    SocketSet::iterator i, t;
+            m_Reactor = new ACE_Reactor(imp, 1);
+        }
 
-    while (!reactor_->reactor_event_loop_done())
-    {
-        ACE_Time_Value interval(0, 10000);
-        if (reactor_->run_reactor_event_loop(interval) == -1)
+        virtual ~ReactorRunnable()
         {
-            break;
+            Stop();
+            Wait();
+
+            delete m_Reactor;
         }
 
-        for (i = sockets_->begin(); i != sockets_->end();)
+        void Stop()
         {
-            if ((*i)->Update() == -1)
+            m_Reactor->end_reactor_event_loop();
+        }
+
+        int Start()
+        {
+            if (m_ThreadId != -1)
             {
-                t = i;
-                ++i;
-                (*t)->CloseSocket();
-                (*t)->RemoveReference();
-                sockets_->erase(t);
+                return -1;
             }
-            else
+
+            return (m_ThreadId = activate());
+        }
+
+        void Wait()
+        {
+            ACE_Task_Base::wait();
+        }
+
+        long Connections()
+        {
+            return static_cast<long>(m_Connections.value());
+        }
+
+        int AddSocket(WorldSocket* sock)
+        {
+            ACE_GUARD_RETURN(ACE_Thread_Mutex, Guard, m_NewSockets_Lock, -1);
+
+            ++m_Connections;
+            sock->AddReference();
+            sock->reactor(m_Reactor);
+            m_NewSockets.insert(sock);
+
+            return 0;
+        }
+
+        ACE_Reactor* GetReactor()
+        {
+            return m_Reactor;
+        }
+
+    protected:
+
+        void AddNewSockets()
+        {
+            ACE_GUARD(ACE_Thread_Mutex, Guard, m_NewSockets_Lock);
+
+            if (m_NewSockets.empty())
             {
-                ++i;
+                return;
             }
+
+            for (SocketSet::const_iterator i = m_NewSockets.begin(); i != m_NewSockets.end(); ++i)
+            {
+                WorldSocket* sock = (*i);
+
+                if (sock->IsClosed())
+                {
+                    sock->RemoveReference();
+                    --m_Connections;
+                }
+                else
+                {
+                    m_Sockets.insert(sock);
+                }
+            }
+
+            m_NewSockets.clear();
         }
-    }
 
-    DEBUG_LOG("Network Thread Exitting");
-    return 0;
-}
+        virtual int svc()
+        {
+            DEBUG_LOG("Network Thread Starting");
+
+            MANGOS_ASSERT(m_Reactor);
+
+            SocketSet::iterator i, t;
+
+            while (!m_Reactor->reactor_event_loop_done())
+            {
+                // dont be too smart to move this outside the loop
+                // the run_reactor_event_loop will modify interval
+                ACE_Time_Value interval(0, 10000);
+
+                if (m_Reactor->run_reactor_event_loop(interval) == -1)
+                {
+                    break;
+                }
+
+                AddNewSockets();
 
+                for (i = m_Sockets.begin(); i != m_Sockets.end();)
+                {
+                    if ((*i)->Update() == -1)
+                    {
+                        t = i;
+                        ++i;
+                        (*t)->CloseSocket();
+                        (*t)->RemoveReference();
+                        --m_Connections;
+                        m_Sockets.erase(t);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+
+            DEBUG_LOG("Network Thread Exitting");
 
+            return 0;
+        }
+
+    private:
+        typedef ACE_Atomic_Op<ACE_SYNCH_MUTEX, long> AtomicInt;
+        typedef std::set<WorldSocket*> SocketSet;
+
+        ACE_Reactor* m_Reactor;
+        AtomicInt m_Connections;
+        int m_ThreadId;
+
+        SocketSet m_Sockets;
+
+        SocketSet m_NewSockets;
+        ACE_Thread_Mutex m_NewSockets_Lock;
+};
+
+WorldSocketMgr::WorldSocketMgr()
+  : m_SockOutKBuff(-1), m_SockOutUBuff(65536), m_UseNoDelay(true),
+    m_NetThreads(NULL), m_NetThreadsCount(0),
+    acceptor_(NULL)
+{
+    InitializeOpcodes();
+}
+
+WorldSocketMgr::~WorldSocketMgr()
+{
+    delete[] m_NetThreads;
+    delete acceptor_;
+}
 
 int WorldSocketMgr::StartNetwork(ACE_INET_Addr& addr)
 {
@@ -105,6 +234,9 @@ int WorldSocketMgr::StartNetwork(ACE_INET_Addr& addr)
         return -1;
     }
 
+    // one more thread for the acceptor
+    m_NetThreadsCount = static_cast<size_t>(num_threads + 1);
+
     m_SockOutUBuff = sConfig.GetIntDefault("Network.OutUBuff", 65536);
     if (m_SockOutUBuff <= 0)
     {
@@ -116,23 +248,22 @@ int WorldSocketMgr::StartNetwork(ACE_INET_Addr& addr)
     m_SockOutKBuff = sConfig.GetIntDefault("Network.OutKBuff", -1);
     m_UseNoDelay = sConfig.GetBoolDefault("Network.TcpNodelay", true);
 
-
-    ACE_Reactor_Impl* imp = 0;
-    imp = new ACE_TP_Reactor();
-    imp->max_notify_iterations(128);
-    reactor_ = new ACE_Reactor(imp, 1);
+    m_NetThreads = new ReactorRunnable[m_NetThreadsCount];
 
     acceptor_ = new WorldAcceptor;
 
-    if (acceptor_->open(addr, reactor_, ACE_NONBLOCK) == -1)
+    if (acceptor_->open(addr, m_NetThreads[0].GetReactor(), ACE_NONBLOCK) == -1)
     {
         sLog.outError("Failed to open acceptor, check if the port is free");
         return -1;
     }
 
-    if (activate(THR_NEW_LWP | THR_JOINABLE, num_threads) == -1)
+    for (size_t i = 0; i < m_NetThreadsCount; ++i)
     {
-        return -1;
+        if (m_NetThreads[i].Start() == -1)
+        {
+            return -1;
+        }
     }
 
     sLog.outString("Max allowed socket connections: %d", ACE::max_handles());
@@ -141,11 +272,20 @@ int WorldSocketMgr::StartNetwork(ACE_INET_Addr& addr)
 
 void WorldSocketMgr::StopNetwork()
 {
-    if (acceptor_) acceptor_->close();
+    if (acceptor_)
+    {
+        acceptor_->close();
+    }
+
+    for (size_t i = 0; i < m_NetThreadsCount; ++i)
+    {
+        m_NetThreads[i].Stop();
+    }
+
+    for (size_t i = 0; i < m_NetThreadsCount; ++i)
     {
-        if (reactor_)  reactor_->end_reactor_event_loop();
+        m_NetThreads[i].Wait();
     }
-    wait();
 }
 
 int WorldSocketMgr::OnSocketOpen(WorldSocket* sock)
@@ -174,9 +314,18 @@ int WorldSocketMgr::OnSocketOpen(WorldSocket* sock)
 
     sock->m_OutBufferSize = static_cast<size_t>(m_SockOutUBuff);
 
-    sock->AddReference();
-    sock->reactor(reactor_);
-    sockets_->insert(sock); //no need for synch here, due to ACE_TSS
+    // we skip the Acceptor Thread
+    size_t min = 1;
 
-    return 0;
+    MANGOS_ASSERT(m_NetThreadsCount >= 1);
+
+    for (size_t i = 1; i < m_NetThreadsCount; ++i)
+    {
+        if (m_NetThreads[i].Connections() < m_NetThreads[min].Connections())
+        {
+            min = i;
+        }
+    }
+
+    return m_NetThreads[min].AddSocket(sock);
 }
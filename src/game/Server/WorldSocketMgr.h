@@ -33,17 +33,19 @@
 
 #include <ace/Basic_Types.h>
 #include <ace/Singleton.h>
-#include <ace/TSS_T.h>
+#include <ace/Thread_Mutex.h>
 #include <ace/INET_Addr.h>
-#include <ace/Task.h>
 #include <ace/Acceptor.h>
 
 class WorldSocket;
+class ReactorRunnable;
 
-/// This is a pool of threads designed to be used by an ACE_TP_Reactor.
-/// Manages all sockets connected to peers
+/// This is a pool of network threads, each running its own reactor.
+/// Manages all sockets connected to peers: the acceptor runs on a
+/// dedicated reactor and every accepted socket is pinned to the
+/// network thread with the fewest connections for its whole life.
 
-class WorldSocketMgr : public ACE_Task_Base
+class WorldSocketMgr
 {
     friend class ACE_Singleton<WorldSocketMgr, ACE_Thread_Mutex>;
     friend class WorldSocket;
@@ -53,7 +55,6 @@ class WorldSocketMgr : public ACE_Task_Base
 
     private:
         int OnSocketOpen(WorldSocket* sock);
-        virtual int svc();
 
         WorldSocketMgr();
         virtual ~WorldSocketMgr();
@@ -63,12 +64,11 @@ class WorldSocketMgr : public ACE_Task_Base
         int m_SockOutUBuff;
         bool m_UseNoDelay;
 
-        ACE_Reactor   *reactor_;
-        WorldAcceptor *acceptor_;
-
-        typedef std::set<WorldSocket*> SocketSet;
-        ACE_TSS<SocketSet> sockets_;
+        /// m_NetThreads[0] only runs the acceptor, the others the sockets
+        ReactorRunnable* m_NetThreads;
+        size_t m_NetThreadsCount;
 
+        WorldAcceptor *acceptor_;
 };
 
 #define sWorldSocketMgr ACE_Singleton<WorldSocketMgr, ACE_Thread_Mutex>::instance()
@@ -447,6 +447,7 @@ void AchievementMgr::Reset()
 
     m_completedAchievements.clear();
     m_criteriaProgress.clear();
+    m_completedCriteria.clear();
     DeleteFromDB(m_player->GetObjectGuid());
 
     // re-fill data
@@ -810,6 +811,7 @@ void AchievementMgr::StartTimedAchievementCriteria(AchievementCriteriaTypes type
 
         progress->changed = true;
         progress->counter = 0;
+        m_completedCriteria.erase(achievementCriteria->ID);
 
         // Start with given startTime or now
         progress->date = startTime ? startTime : time(NULL);
@@ -862,6 +864,7 @@ void AchievementMgr::DoFailedTimedAchievementCriterias()
 
             // Remove failed progress
             m_criteriaProgress.erase(pro_iter);
+            m_completedCriteria.erase(criteria->ID);
         }
 
         m_criteriaFailTimes.erase(iter++);
@@ -880,11 +883,17 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
         return;
     }
 
-    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr.GetAchievementCriteriaByType(type);
+    AchievementCriteriaEntryList const& achievementCriteriaList = sAchievementMgr.GetAchievementCriteriaByType(type, miscvalue1);
     for (AchievementCriteriaEntryList::const_iterator itr = achievementCriteriaList.begin(); itr != achievementCriteriaList.end(); ++itr)
     {
         AchievementCriteriaEntry const* achievementCriteria = *itr;
 
+        // don't update already completed criteria
+        if (m_completedCriteria.find(achievementCriteria->ID) != m_completedCriteria.end())
+        {
+            continue;
+        }
+
         AchievementEntry const* achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
         // Checked in LoadAchievementCriteriaList
 
@@ -892,9 +901,13 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
                 (achievement->factionFlag == ACHIEVEMENT_FACTION_FLAG_ALLIANCE && GetPlayer()->GetTeam() != ALLIANCE))
             continue;
 
-        // don't update already completed criteria
         if (IsCompletedCriteria(achievementCriteria, achievement))
         {
+            // realm first criteria count as not completed again once someone got the achievement
+            if (!(achievement->flags & (ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL)))
+            {
+                m_completedCriteria.insert(achievementCriteria->ID);
+            }
             continue;
         }
 
@@ -2394,6 +2407,7 @@ void AchievementMgr::SetCriteriaProgress(AchievementCriteriaEntry const* criteri
 
     progress->counter = newValue;
     progress->changed = true;
+    m_completedCriteria.erase(criteria->ID);
 
     // update client side value
     SendCriteriaUpdate(criteria->ID, progress);
@@ -2731,6 +2745,54 @@ AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteria
     return m_AchievementCriteriasByType[type];
 }
 
+/**
+ * Criteria of these types only progress when miscvalue1, if set, equals their first data field
+ * (creature, item, spell, quest...), see AchievementMgr::UpdateAchievementCriteria
+ */
+static bool IsCriteriaKeyedByMiscValue(AchievementCriteriaTypes type)
+{
+    switch (type)
+    {
+        case ACHIEVEMENT_CRITERIA_TYPE_KILL_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_REACH_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SKILL_LEVEL:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUESTS_IN_ZONE:
+        case ACHIEVEMENT_CRITERIA_TYPE_KILLED_BY_CREATURE:
+        case ACHIEVEMENT_CRITERIA_TYPE_COMPLETE_QUEST:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET:
+        case ACHIEVEMENT_CRITERIA_TYPE_BE_SPELL_TARGET2:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_CAST_SPELL2:
+        case ACHIEVEMENT_CRITERIA_TYPE_LEARN_SPELL:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_TYPE:
+        case ACHIEVEMENT_CRITERIA_TYPE_OWN_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_LOOT_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_GAIN_REPUTATION:
+        case ACHIEVEMENT_CRITERIA_TYPE_DO_EMOTE:
+        case ACHIEVEMENT_CRITERIA_TYPE_EQUIP_ITEM:
+        case ACHIEVEMENT_CRITERIA_TYPE_USE_GAMEOBJECT:
+        case ACHIEVEMENT_CRITERIA_TYPE_FISH_IN_GAMEOBJECT:
+            return true;
+        default:
+            return false;
+    }
+}
+
+AchievementCriteriaEntryList const& AchievementGlobalMgr::GetAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 miscvalue1)
+{
+    // login and similar full updates pass no miscvalue and need all criteria
+    if (!miscvalue1 || !IsCriteriaKeyedByMiscValue(type))
+    {
+        return m_AchievementCriteriasByType[type];
+    }
+
+    static AchievementCriteriaEntryList const emptyList;
+
+    AchievementCriteriaListByMiscValue::const_iterator itr = m_AchievementCriteriasByMiscValue[type].find(miscvalue1);
+    return itr != m_AchievementCriteriasByMiscValue[type].end() ? itr->second : emptyList;
+}
+
 AchievementCriteriaEntryList const* AchievementGlobalMgr::GetAchievementCriteriaByAchievement(uint32 id)
 {
     AchievementCriteriaListByAchievement::const_iterator itr = m_AchievementCriteriaListByAchievement.find(id);
@@ -2820,6 +2882,11 @@ void AchievementGlobalMgr::LoadAchievementCriteriaList()
 
         m_AchievementCriteriasByType[criteria->requiredType].push_back(criteria);
         m_AchievementCriteriaListByAchievement[criteria->referredAchievement].push_back(criteria);
+
+        if (IsCriteriaKeyedByMiscValue(AchievementCriteriaTypes(criteria->requiredType)))
+        {
+            m_AchievementCriteriasByMiscValue[criteria->requiredType][criteria->raw.value].push_back(criteria);
+        }
         ++count;
     }
 
@@ -41,6 +41,7 @@ typedef std::list<AchievementCriteriaEntry const*> AchievementCriteriaEntryList;
 typedef std::list<AchievementEntry const*>         AchievementEntryList;
 
 typedef std::map<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByAchievement;
+typedef std::map<uint32, AchievementCriteriaEntryList> AchievementCriteriaListByMiscValue;
 typedef std::map<uint32, AchievementEntryList>         AchievementListByReferencedId;
 typedef std::map<uint32, time_t>                       AchievementCriteriaFailTimeMap;
 
@@ -310,12 +311,17 @@ class AchievementMgr
         CriteriaProgressMap m_criteriaProgress;
         CompletedAchievementMap m_completedAchievements;
         AchievementCriteriaFailTimeMap m_criteriaFailTimes;
+
+        // criteria found completed by UpdateAchievementCriteria, dropped whenever their progress changes
+        typedef UNORDERED_SET<uint32> CompletedCriteriaSet;
+        CompletedCriteriaSet m_completedCriteria;
 };
 
 class AchievementGlobalMgr
 {
     public:
         AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type);
+        AchievementCriteriaEntryList const& GetAchievementCriteriaByType(AchievementCriteriaTypes type, uint32 miscvalue1);
         AchievementCriteriaEntryList const* GetAchievementCriteriaByAchievement(uint32 id);
         AchievementEntryList const* GetAchievementByReferencedId(uint32 id) const;
         AchievementReward const* GetAchievementReward(AchievementEntry const* achievement, uint8 gender) const;
@@ -337,6 +343,8 @@ class AchievementGlobalMgr
 
         // store achievement criterias by type to speed up lookup
         AchievementCriteriaEntryList m_AchievementCriteriasByType[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
+        // store achievement criterias of types keyed by miscvalue1 (creature, item, spell...) also by that value
+        AchievementCriteriaListByMiscValue m_AchievementCriteriasByMiscValue[ACHIEVEMENT_CRITERIA_TYPE_TOTAL];
         // store achievement criterias by achievement to speed up lookup
         AchievementCriteriaListByAchievement m_AchievementCriteriaListByAchievement;
         // store achievements by referenced achievement id to speed up lookup
@@ -700,19 +700,6 @@ void WorldSession::HandleAuctionListItems(WorldPacket& recv_data)
     // always return pointer
     AuctionHouseObject* auctionHouse = sAuctionMgr.GetAuctionsMap(auctionHouseEntry);
 
-    // Sort
-    AuctionHouseObject::AuctionEntryMap const& aucs = auctionHouse->GetAuctions();
-    std::vector<AuctionEntry*> auctions;
-    auctions.reserve(aucs.size());
-
-    for (AuctionHouseObject::AuctionEntryMap::const_iterator itr = aucs.begin(); itr != aucs.end(); ++itr)
-    {
-        auctions.push_back(itr->second);
-    }
-
-    AuctionSorter sorter(Sort, GetPlayer());
-    std::sort(auctions.begin(), auctions.end(), sorter);
-
     // DEBUG_LOG("Auctionhouse search %s list from: %u, searchedname: %s, levelmin: %u, levelmax: %u, auctionSlotID: %u, auctionMainCategory: %u, auctionSubCategory: %u, quality: %u, usable: %u",
     //  auctioneerGuid.GetString().c_str(), listfrom, searchedname.c_str(), levelmin, levelmax, auctionSlotID, auctionMainCategory, auctionSubCategory, quality, usable);
 
@@ -730,7 +717,7 @@ void WorldSession::HandleAuctionListItems(WorldPacket& recv_data)
 
     wstrToLower(wsearchedname);
 
-    BuildListAuctionItems(auctions, data, wsearchedname, listfrom, levelmin, levelmax, usable,
+    BuildListAuctionItems(auctionHouse, Sort, data, wsearchedname, listfrom, levelmin, levelmax, usable,
                           auctionSlotID, auctionMainCategory, auctionSubCategory, quality, count, totalcount, isFull);
 
     data.put<uint32>(0, count);
@@ -25,6 +25,7 @@
 #include "Channel.h"
 #include "ObjectMgr.h"
 #include "World.h"
+#include "SharedWorldPacket.h"
 #include "SocialMgr.h"
 #include "Chat.h"
 
@@ -717,11 +718,12 @@ void Channel::Invite(Player* player, const char* targetName)
 
 void Channel::SendToAll(WorldPacket* data, ObjectGuid guid)
 {
+    SharedWorldPacket shared(*data);
     for (PlayerList::const_iterator i = m_players.begin(); i != m_players.end(); ++i)
         if (Player* plr = sObjectMgr.GetPlayer(i->first))
             if (!guid || !plr->GetSocial()->HasIgnore(guid))
             {
-                plr->GetSession()->SendPacket(data);
+                plr->GetSession()->SendPacket(shared);
             }
 }
 
@@ -36,6 +36,13 @@
 #include "Policies/Singleton.h"
 #include "Util.h"
 
+#include <ace/Mem_Map.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define GRIDMAP_USE_SSE2
+#  include <emmintrin.h>
+#endif
+
 #include <mutex>
 
 char const* MAP_MAGIC         = "MAPS";
@@ -72,6 +79,8 @@ GridMap::GridMap()
     m_liquidFlags = NULL;
     m_liquidEntry = NULL;
     m_liquid_map  = NULL;
+
+    m_mapping = NULL;
 }
 
 GridMap::~GridMap()
@@ -84,6 +93,13 @@ bool GridMap::loadData(char* filename)
     // Unload old data if exist
     unloadData();
 
+    // Point the grid arrays straight into a read-only mapping of the file, pages are shared
+    // through the OS page cache; fall back to reading into heap buffers if the map fails
+    if (sWorld.getConfig(CONFIG_BOOL_MAP_FILE_MMAP) && loadMappedData(filename))
+    {
+        return true;
+    }
+
     GridMapFileHeader header;
     // Not return error if file not found
     FILE* in = fopen(filename, "rb");
@@ -132,12 +148,34 @@ bool GridMap::loadData(char* filename)
 
 void GridMap::unloadData()
 {
-    delete[] m_area_map;
-    delete[] m_V9;
-    delete[] m_V8;
-    delete[] m_liquidEntry;
-    delete[] m_liquidFlags;
-    delete[] m_liquid_map;
+    // Arrays pointing into the mapping are released by unmapping the file
+    if (!isMappedPointer(m_area_map))
+    {
+        delete[] m_area_map;
+    }
+    if (!isMappedPointer(m_V9))
+    {
+        delete[] m_V9;
+    }
+    if (!isMappedPointer(m_V8))
+    {
+        delete[] m_V8;
+    }
+    if (!isMappedPointer(m_liquidEntry))
+    {
+        delete[] m_liquidEntry;
+    }
+    if (!isMappedPointer(m_liquidFlags))
+    {
+        delete[] m_liquidFlags;
+    }
+    if (!isMappedPointer(m_liquid_map))
+    {
+        delete[] m_liquid_map;
+    }
+
+    delete m_mapping;
+    m_mapping = NULL;
 
     m_area_map = NULL;
     m_V9 = NULL;
@@ -265,6 +303,204 @@ bool GridMap::loadGridMapLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
+bool GridMap::isMappedPointer(void const* ptr) const
+{
+    if (!m_mapping || !ptr)
+    {
+        return false;
+    }
+
+    char const* begin = static_cast<char const*>(m_mapping->addr());
+    char const* p = static_cast<char const*>(ptr);
+    return p >= begin && p < begin + m_mapping->size();
+}
+
+template<typename T>
+T* GridMap::mapArray(char const* data, size_t dataSize, size_t pos, size_t count)
+{
+    if (pos > dataSize || count * sizeof(T) > dataSize - pos)
+    {
+        return NULL;
+    }
+
+    char const* src = data + pos;
+    // Map files are not guaranteed to keep sections aligned, copy out what can not be used in place
+    if (reinterpret_cast<uintptr_t>(src) % alignof(T) == 0)
+    {
+        return reinterpret_cast<T*>(const_cast<char*>(src));
+    }
+
+    T* copy = new T[count];
+    memcpy(copy, src, count * sizeof(T));
+    return copy;
+}
+
+bool GridMap::loadMappedData(char const* filename)
+{
+    m_mapping = new ACE_Mem_Map();
+    if (m_mapping->map(filename, static_cast<size_t>(-1), O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_SHARED) == -1 ||
+            !m_mapping->addr() || m_mapping->size() < sizeof(GridMapFileHeader))
+    {
+        delete m_mapping;
+        m_mapping = NULL;
+        return false;
+    }
+
+    // The mapping stays valid without the descriptor, do not hold one open per loaded grid
+    m_mapping->close_handle();
+
+    char const* data = static_cast<char const*>(m_mapping->addr());
+    size_t dataSize = m_mapping->size();
+
+    GridMapFileHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.mapMagic     != *((uint32 const*)(MAP_MAGIC)) ||
+            header.versionMagic != *((uint32 const*)(MAP_VERSION_MAGIC)) ||
+            !IsAcceptableClientBuild(header.buildMagic))
+    {
+        unloadData();
+        return false;
+    }
+
+    if ((header.areaMapOffset && !loadAreaData(data, dataSize, header.areaMapOffset)) ||
+            (header.heightMapOffset && !loadHeightData(data, dataSize, header.heightMapOffset)) ||
+            (header.liquidMapOffset && !loadGridMapLiquidData(data, dataSize, header.liquidMapOffset)))
+    {
+        sLog.outError("Error mapping map file '%s', falling back to buffered load", filename);
+        unloadData();
+        return false;
+    }
+
+    return true;
+}
+
+bool GridMap::loadAreaData(char const* data, size_t dataSize, uint32 offset)
+{
+    GridMapAreaHeader header;
+    if (offset > dataSize || dataSize - offset < sizeof(header))
+    {
+        return false;
+    }
+
+    memcpy(&header, data + offset, sizeof(header));
+    if (header.fourcc != *((uint32 const*)(MAP_AREA_MAGIC)))
+    {
+        return false;
+    }
+
+    m_gridArea = header.gridArea;
+    if (!(header.flags & MAP_AREA_NO_AREA))
+    {
+        m_area_map = mapArray<uint16>(data, dataSize, offset + sizeof(header), 16 * 16);
+        if (!m_area_map)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool GridMap::loadHeightData(char const* data, size_t dataSize, uint32 offset)
+{
+    GridMapHeightHeader header;
+    if (offset > dataSize || dataSize - offset < sizeof(header))
+    {
+        return false;
+    }
+
+    memcpy(&header, data + offset, sizeof(header));
+    if (header.fourcc != *((uint32 const*)(MAP_HEIGHT_MAGIC)))
+    {
+        return false;
+    }
+
+    size_t pos = offset + sizeof(header);
+    m_gridHeight = header.gridHeight;
+    if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
+    {
+        if ((header.flags & MAP_HEIGHT_AS_INT16))
+        {
+            m_uint16_V9 = mapArray<uint16>(data, dataSize, pos, 129 * 129);
+            m_uint16_V8 = mapArray<uint16>(data, dataSize, pos + 129 * 129 * sizeof(uint16), 128 * 128);
+            m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
+            m_gridGetHeight = &GridMap::getHeightFromUint16;
+        }
+        else if ((header.flags & MAP_HEIGHT_AS_INT8))
+        {
+            m_uint8_V9 = mapArray<uint8>(data, dataSize, pos, 129 * 129);
+            m_uint8_V8 = mapArray<uint8>(data, dataSize, pos + 129 * 129 * sizeof(uint8), 128 * 128);
+            m_gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
+            m_gridGetHeight = &GridMap::getHeightFromUint8;
+        }
+        else
+        {
+            m_V9 = mapArray<float>(data, dataSize, pos, 129 * 129);
+            m_V8 = mapArray<float>(data, dataSize, pos + 129 * 129 * sizeof(float), 128 * 128);
+            m_gridGetHeight = &GridMap::getHeightFromFloat;
+        }
+
+        if (!m_V9 || !m_V8)
+        {
+            return false;
+        }
+    }
+    else
+    {
+        m_gridGetHeight = &GridMap::getHeightFromFlat;
+    }
+
+    return true;
+}
+
+bool GridMap::loadGridMapLiquidData(char const* data, size_t dataSize, uint32 offset)
+{
+    GridMapLiquidHeader header;
+    if (offset > dataSize || dataSize - offset < sizeof(header))
+    {
+        return false;
+    }
+
+    memcpy(&header, data + offset, sizeof(header));
+    if (header.fourcc != *((uint32 const*)(MAP_LIQUID_MAGIC)))
+    {
+        return false;
+    }
+
+    m_liquidType    = header.liquidType;
+    m_liquid_offX   = header.offsetX;
+    m_liquid_offY   = header.offsetY;
+    m_liquid_width  = header.width;
+    m_liquid_height = header.height;
+    m_liquidLevel   = header.liquidLevel;
+
+    size_t pos = offset + sizeof(header);
+    if (!(header.flags & MAP_LIQUID_NO_TYPE))
+    {
+        m_liquidEntry = mapArray<uint16>(data, dataSize, pos, 16 * 16);
+        pos += 16 * 16 * sizeof(uint16);
+
+        m_liquidFlags = mapArray<uint8>(data, dataSize, pos, 16 * 16);
+        pos += 16 * 16 * sizeof(uint8);
+
+        if (!m_liquidEntry || !m_liquidFlags)
+        {
+            return false;
+        }
+    }
+
+    if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
+    {
+        m_liquid_map = mapArray<float>(data, dataSize, pos, m_liquid_width * m_liquid_height);
+        if (!m_liquid_map)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 uint16 GridMap::getArea(float x, float y)
 {
     if (!m_area_map)
@@ -385,6 +621,114 @@ float GridMap::getHeightFromFloat(float x, float y) const
     return a * x + b * y + c;
 }
 
+#ifdef GRIDMAP_USE_SSE2
+// mask ? a : b, lane by lane
+static inline __m128 SelectLanes(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+// Same results as getHeightFromFloat() for each point. With SSE2 four points are
+// interpolated at once: the corner heights of all four cells are gathered, the
+// coefficients of every triangle computed and the right ones picked by mask
+// instead of branching on the triangle of each point.
+void GridMap::getHeightsFromFloat(uint32 count, float const* x, float const* y, float* heights) const
+{
+    if (!m_V8 || !m_V9)
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            heights[i] = INVALID_HEIGHT_VALUE;
+        }
+        return;
+    }
+
+    uint32 i = 0;
+
+#ifdef GRIDMAP_USE_SSE2
+    const __m128 resolution = _mm_set1_ps(MAP_RESOLUTION);
+    const __m128 centre = _mm_set1_ps(32.0f);
+    const __m128 gridSize = _mm_set1_ps(SIZE_OF_GRIDS);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128i cellMask = _mm_set1_epi32(MAP_RESOLUTION - 1);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 fx = _mm_mul_ps(resolution, _mm_sub_ps(centre, _mm_div_ps(_mm_loadu_ps(x + i), gridSize)));
+        __m128 fy = _mm_mul_ps(resolution, _mm_sub_ps(centre, _mm_div_ps(_mm_loadu_ps(y + i), gridSize)));
+
+        __m128i ix = _mm_cvttps_epi32(fx);
+        __m128i iy = _mm_cvttps_epi32(fy);
+        fx = _mm_sub_ps(fx, _mm_cvtepi32_ps(ix));
+        fy = _mm_sub_ps(fy, _mm_cvtepi32_ps(iy));
+
+        int32 cellX[4], cellY[4];
+        _mm_storeu_si128((__m128i*)cellX, _mm_and_si128(ix, cellMask));
+        _mm_storeu_si128((__m128i*)cellY, _mm_and_si128(iy, cellMask));
+
+        // corners h1-h4 from the v9 grid and centre h5 from the v8 grid, see getHeightFromFloat()
+        float c1[4], c2[4], c3[4], c4[4], c5[4];
+        for (int k = 0; k < 4; ++k)
+        {
+            float const* v9 = &m_V9[cellX[k] * 129 + cellY[k]];
+            c1[k] = v9[0];
+            c2[k] = v9[129];
+            c3[k] = v9[1];
+            c4[k] = v9[130];
+            c5[k] = 2 * m_V8[cellX[k] * 128 + cellY[k]];
+        }
+
+        __m128 h1 = _mm_loadu_ps(c1);
+        __m128 h2 = _mm_loadu_ps(c2);
+        __m128 h3 = _mm_loadu_ps(c3);
+        __m128 h4 = _mm_loadu_ps(c4);
+        __m128 h5 = _mm_loadu_ps(c5);
+
+        // triangles 1 and 2 lie above the x + y = 1 diagonal, triangles 1 and 3 right of x = y
+        __m128 upper = _mm_cmplt_ps(_mm_add_ps(fx, fy), one);
+        __m128 right = _mm_cmpgt_ps(fx, fy);
+
+        __m128 a = SelectLanes(upper,
+                               SelectLanes(right, _mm_sub_ps(h2, h1), _mm_sub_ps(_mm_sub_ps(h5, h1), h3)),
+                               SelectLanes(right, _mm_sub_ps(_mm_add_ps(h2, h4), h5), _mm_sub_ps(h4, h3)));
+        __m128 b = SelectLanes(upper,
+                               SelectLanes(right, _mm_sub_ps(_mm_sub_ps(h5, h1), h2), _mm_sub_ps(h3, h1)),
+                               SelectLanes(right, _mm_sub_ps(h4, h2), _mm_sub_ps(_mm_add_ps(h3, h4), h5)));
+        __m128 c = SelectLanes(upper, h1, _mm_sub_ps(h5, h4));
+
+        _mm_storeu_ps(heights + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, fx), _mm_mul_ps(b, fy)), c));
+
+        for (int k = 0; k < 4; ++k)
+        {
+            if (isHole(cellX[k], cellY[k]))
+            {
+                heights[i + k] = INVALID_HEIGHT_VALUE;
+            }
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        heights[i] = getHeightFromFloat(x[i], y[i]);
+    }
+}
+
+void GridMap::getHeights(uint32 count, float const* x, float const* y, float* heights) const
+{
+    if (m_gridGetHeight == &GridMap::getHeightFromFloat)
+    {
+        getHeightsFromFloat(count, x, y, heights);
+        return;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        heights[i] = (this->*m_gridGetHeight)(x[i], y[i]);
+    }
+}
+
 float GridMap::getHeightFromUint8(float x, float y) const
 {
     if (!m_uint8_V8 || !m_uint8_V9)
@@ -747,8 +1091,8 @@ TerrainInfo::TerrainInfo(uint32 mapid) : m_mapId(mapid)
     {
         for (int i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
         {
-            m_GridMaps[i][k] = NULL;
-            m_GridRef[i][k] = 0;
+            m_GridMaps[i][k].store(NULL, std::memory_order_relaxed);
+            m_GridRef[i][k].store(0, std::memory_order_relaxed);
         }
     }
 
@@ -766,9 +1110,14 @@ TerrainInfo::~TerrainInfo()
     for (int k = 0; k < MAX_NUMBER_OF_GRIDS; ++k)
         for (int i = 0; i < MAX_NUMBER_OF_GRIDS; ++i)
         {
-            delete m_GridMaps[i][k];
+            delete m_GridMaps[i][k].load(std::memory_order_relaxed);
         }
 
+    for (std::vector<GridMap*>::const_iterator itr = m_retiredGridMaps.begin(); itr != m_retiredGridMaps.end(); ++itr)
+    {
+        delete *itr;
+    }
+
     VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId);
     MMAP::MMapFactory::createOrGetMMapManager()->unloadMap(m_mapId);
 }
@@ -782,7 +1131,7 @@ GridMap* TerrainInfo::Load(const uint32 x, const uint32 y)
     RefGrid(x, y);
 
     // quick check if GridMap already loaded
-    GridMap* pMap = m_GridMaps[x][y];
+    GridMap* pMap = m_GridMaps[x][y].load(std::memory_order_acquire);
     if (!pMap)
     {
         pMap = LoadMapAndVMap(x, y);
@@ -797,7 +1146,7 @@ void TerrainInfo::Unload(const uint32 x, const uint32 y)
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
     MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
 
-    if (m_GridMaps[x][y])
+    if (m_GridMaps[x][y].load(std::memory_order_acquire))
     {
         // decrease grid reference count...
         if (UnrefGrid(x, y) == 0)
@@ -816,20 +1165,30 @@ void TerrainInfo::CleanUpGrids(const uint32 diff)
         return;
     }
 
+    // grids retired by the previous pass can no longer be in use: every map
+    // update that could have picked them up before they were unpublished is over
+    for (std::vector<GridMap*>::const_iterator itr = m_retiredGridMaps.begin(); itr != m_retiredGridMaps.end(); ++itr)
+    {
+        (*itr)->unloadData();
+        delete *itr;
+    }
+    m_retiredGridMaps.clear();
+
+    // keep grid loading out while tiles are dropped
+    LOCK_GUARD lock(m_mutex);
+
     for (int y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
     {
         for (int x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
         {
-            const int16& iRef = m_GridRef[x][y];
-            GridMap* pMap = m_GridMaps[x][y];
+            GridMap* pMap = m_GridMaps[x][y].load(std::memory_order_acquire);
 
-            // delete those GridMap objects which have refcount = 0
-            if (pMap && iRef == 0)
+            // unpublish those GridMap objects which have refcount = 0
+            if (pMap && m_GridRef[x][y].load(std::memory_order_acquire) == 0)
             {
-                m_GridMaps[x][y] = NULL;
-                // delete grid data if reference count == 0
-                pMap->unloadData();
-                delete pMap;
+                m_GridMaps[x][y].store(NULL, std::memory_order_release);
+                // lookups may still hold the pointer, delete it on the next pass
+                m_retiredGridMaps.push_back(pMap);
 
                 // unload VMAPS...
                 VMAP::VMapFactory::createOrGetVMapManager()->unloadMap(m_mapId, x, y);
@@ -848,8 +1207,7 @@ int TerrainInfo::RefGrid(const uint32& x, const uint32& y)
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
     MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
 
-    LOCK_GUARD _lock(m_refMutex);
-    return (m_GridRef[x][y] += 1);
+    return m_GridRef[x][y].fetch_add(1, std::memory_order_acq_rel) + 1;
 }
 
 int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
@@ -857,12 +1215,15 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
     MANGOS_ASSERT(x < MAX_NUMBER_OF_GRIDS);
     MANGOS_ASSERT(y < MAX_NUMBER_OF_GRIDS);
 
-    int16& iRef = m_GridRef[x][y];
+    std::atomic<int16>& iRef = m_GridRef[x][y];
 
-    LOCK_GUARD _lock(m_refMutex);
-    if (iRef > 0)
+    int16 refs = iRef.load(std::memory_order_acquire);
+    while (refs > 0)
     {
-        return (iRef -= 1);
+        if (iRef.compare_exchange_weak(refs, int16(refs - 1), std::memory_order_acq_rel))
+        {
+            return refs - 1;
+        }
     }
 
     return 0;
@@ -871,9 +1232,6 @@ int TerrainInfo::UnrefGrid(const uint32& x, const uint32& y)
 float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
 {
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;            // Store Height obtained by maps
-    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
-
-    float z2 = z + 2.f;
 
     // find raw .map surface under Z coordinates (or well-defined above)
     if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x, y))
@@ -881,6 +1239,51 @@ float TerrainInfo::GetHeightStatic(float x, float y, float z, bool useVmaps/*=tr
         mapHeight = gmap->getHeight(x, y);
     }
 
+    return SelectHeightStatic(x, y, z, mapHeight, useVmaps, maxSearchDist);
+}
+
+void TerrainInfo::GetHeightsStatic(uint32 count, float const* x, float const* y, float const* z, float* heights, bool useVmaps/*=true*/, float maxSearchDist/*=DEFAULT_HEIGHT_SEARCH*/) const
+{
+    // raw .map surface, one batch per run of points in the same grid
+    for (uint32 first = 0; first < count;)
+    {
+        int gx = (int)(32 - x[first] / SIZE_OF_GRIDS);
+        int gy = (int)(32 - y[first] / SIZE_OF_GRIDS);
+
+        uint32 last = first + 1;
+        while (last < count && (int)(32 - x[last] / SIZE_OF_GRIDS) == gx && (int)(32 - y[last] / SIZE_OF_GRIDS) == gy)
+        {
+            ++last;
+        }
+
+        if (GridMap* gmap = const_cast<TerrainInfo*>(this)->GetGrid(x[first], y[first]))
+        {
+            gmap->getHeights(last - first, x + first, y + first, heights + first);
+        }
+        else
+        {
+            for (uint32 i = first; i < last; ++i)
+            {
+                heights[i] = VMAP_INVALID_HEIGHT_VALUE;
+            }
+        }
+
+        first = last;
+    }
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        heights[i] = SelectHeightStatic(x[i], y[i], z[i], heights[i], useVmaps, maxSearchDist);
+    }
+}
+
+// pick between the .map height and the vmap height found around z
+float TerrainInfo::SelectHeightStatic(float x, float y, float z, float mapHeight, bool useVmaps, float maxSearchDist) const
+{
+    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;           // Store Height obtained by vmaps (in "corridor" of z (or slightly above z)
+
+    float z2 = z + 2.f;
+
     if (useVmaps)
     {
         VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
@@ -1276,7 +1679,7 @@ GridMap* TerrainInfo::GetGrid(const float x, const float y)
     int gy = (int)(32 - y / SIZE_OF_GRIDS);                 // grid y
 
     // quick check if GridMap already loaded
-    GridMap* pMap = m_GridMaps[gx][gy];
+    GridMap* pMap = m_GridMaps[gx][gy].load(std::memory_order_acquire);
     if (!pMap)
     {
         pMap = LoadMapAndVMap(gx, gy);
@@ -1288,11 +1691,13 @@ GridMap* TerrainInfo::GetGrid(const float x, const float y)
 GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
 {
     // double checked lock pattern
-    if (!m_GridMaps[x][y])
+    GridMap* pMap = m_GridMaps[x][y].load(std::memory_order_acquire);
+    if (!pMap)
     {
         LOCK_GUARD lock(m_mutex);
 
-        if (!m_GridMaps[x][y])
+        pMap = m_GridMaps[x][y].load(std::memory_order_acquire);
+        if (!pMap)
         {
             GridMap* map = new GridMap();
 
@@ -1309,7 +1714,6 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
             }
 
             delete[] tmp;
-            m_GridMaps[x][y] = map;
 
             // load VMAPs for current map/grid...
             const MapEntry* i_mapEntry = sMapStore.LookupEntry(m_mapId);
@@ -1331,10 +1735,14 @@ GridMap* TerrainInfo::LoadMapAndVMap(const uint32 x, const uint32 y)
 
             // load navmesh
             MMAP::MMapFactory::createOrGetMMapManager()->loadMap(m_mapId, x, y);
+
+            // publish only once the grid and its vmap/mmap tiles are ready
+            m_GridMaps[x][y].store(map, std::memory_order_release);
+            pMap = map;
         }
     }
 
-    return  m_GridMaps[x][y];
+    return pMap;
 }
 
 float TerrainInfo::GetWaterLevel(float x, float y, float z, float* pGround /*= NULL*/) const
@@ -32,11 +32,15 @@
 #include "Object.h"
 #include "SharedDefines.h"
 
+#include <atomic>
 #include <bitset>
 #include <list>
+#include <vector>
 
 #include <mutex>
 
+class ACE_Mem_Map;
+
 class Creature;
 class Unit;
 class WorldPacket;
@@ -163,10 +167,21 @@ class GridMap
         uint8* m_liquidFlags;
         float* m_liquid_map;
 
+        // Read-only mapping of the .map file, NULL when loaded into heap buffers
+        ACE_Mem_Map* m_mapping;
+
         bool loadAreaData(FILE* in, uint32 offset, uint32 size);
         bool loadHeightData(FILE* in, uint32 offset, uint32 size);
         bool loadGridMapLiquidData(FILE* in, uint32 offset, uint32 size);
         bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+
+        bool loadMappedData(char const* filename);
+        bool loadAreaData(char const* data, size_t dataSize, uint32 offset);
+        bool loadHeightData(char const* data, size_t dataSize, uint32 offset);
+        bool loadGridMapLiquidData(char const* data, size_t dataSize, uint32 offset);
+        bool isMappedPointer(void const* ptr) const;
+        template<typename T>
+        T* mapArray(char const* data, size_t dataSize, size_t pos, size_t count);
         bool isHole(int row, int col) const;
 
         // Get height functions and pointers
@@ -176,6 +191,7 @@ class GridMap
         float getHeightFromUint16(float x, float y) const;
         float getHeightFromUint8(float x, float y) const;
         float getHeightFromFlat(float x, float y) const;
+        void getHeightsFromFloat(uint32 count, float const* x, float const* y, float* heights) const;
 
     public:
 
@@ -190,6 +206,8 @@ class GridMap
 
         uint16 getArea(float x, float y);
         float getHeight(float x, float y) { return (this->*m_gridGetHeight)(x, y); }
+        // getHeight() for count points at once, all of them inside this grid
+        void getHeights(uint32 count, float const* x, float const* y, float* heights) const;
         float getLiquidLevel(float x, float y);
         uint8 getTerrainType(float x, float y);
         GridMapLiquidStatus getLiquidStatus(float x, float y, float z, uint8 ReqLiquidType, GridMapLiquidData* data = 0);
@@ -222,6 +240,11 @@ typedef ACE_Atomic_Op<ACE_Thread_Mutex, long> AtomicLong;
 #define DEFAULT_WATER_SEARCH      50.0f                     // default search distance to case detection water level
 
 // class for sharing and managin GridMap objects
+//
+// Loaded GridMap objects are published through atomic pointers, so terrain
+// queries from any map thread never lock. Loading a missing grid takes m_mutex,
+// and grids dropped by CleanUpGrids are only deleted on the following pass,
+// once every thread that could still be reading them has finished its update.
 class  TerrainInfo : public Referencable<AtomicLong>
 {
     public:
@@ -233,6 +256,8 @@ class  TerrainInfo : public Referencable<AtomicLong>
         // TODO: move all terrain/vmaps data info query functions
         // from 'Map' class into this class
         float GetHeightStatic(float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+        // GetHeightStatic() for count points, .map heights of points in the same grid are read in one batch
+        void GetHeightsStatic(uint32 count, float const* x, float const* y, float const* z, float* heights, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
         float GetWaterLevel(float x, float y, float z, float* pGround = NULL) const;
         float GetWaterOrGroundLevel(float x, float y, float z, float* pGround = NULL, bool swim = false) const;
         bool IsInWater(float x, float y, float z, GridMapLiquidData* data = 0) const;
@@ -269,6 +294,7 @@ class  TerrainInfo : public Referencable<AtomicLong>
         TerrainInfo& operator=(const TerrainInfo&);
 
         GridMap* GetGrid(const float x, const float y);
+        float SelectHeightStatic(float x, float y, float z, float mapHeight, bool useVmaps, float maxSearchDist) const;
         GridMap* LoadMapAndVMap(const uint32 x, const uint32 y);
 
         int RefGrid(const uint32& x, const uint32& y);
@@ -276,16 +302,18 @@ class  TerrainInfo : public Referencable<AtomicLong>
 
         const uint32 m_mapId;
 
-        GridMap* m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
-        int16 m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        std::atomic<GridMap*> m_GridMaps[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+        std::atomic<int16> m_GridRef[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
+
+        // grids unpublished by the last CleanUpGrids pass, deleted on the next one
+        std::vector<GridMap*> m_retiredGridMaps;
 
         // global garbage collection timer
         IntervalTimer i_timer;
 
         typedef ACE_Thread_Mutex LOCK_TYPE;
         typedef ACE_Guard<LOCK_TYPE> LOCK_GUARD;
-        LOCK_TYPE m_mutex;
-        LOCK_TYPE m_refMutex;
+        LOCK_TYPE m_mutex;                                  // serializes grid loading only
 };
 
 // class for managing TerrainData object and all sort of geometry querying operations
@@ -27,6 +27,7 @@
 
 #include "ObjectGridLoader.h"
 #include "UpdateData.h"
+#include "SharedWorldPacket.h"
 #include <iostream>
 
 #include "Corpse.h"
@@ -63,9 +64,9 @@ namespace MaNGOS
     struct MessageDeliverer
     {
         Player const& i_player;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         bool i_toSelf;
-        MessageDeliverer(Player const& pl, WorldPacket* msg, bool to_self) : i_player(pl), i_message(msg), i_toSelf(to_self) {}
+        MessageDeliverer(Player const& pl, WorldPacket* msg, bool to_self) : i_player(pl), i_message(*msg), i_toSelf(to_self) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
     };
@@ -73,11 +74,11 @@ namespace MaNGOS
     struct MessageDelivererExcept
     {
         uint32        i_phaseMask;
-        WorldPacket*  i_message;
+        SharedWorldPacket i_message;
         Player const* i_skipped_receiver;
 
         MessageDelivererExcept(WorldObject const* obj, WorldPacket* msg, Player const* skipped)
-            : i_phaseMask(obj->GetPhaseMask()), i_message(msg), i_skipped_receiver(skipped) {}
+            : i_phaseMask(obj->GetPhaseMask()), i_message(*msg), i_skipped_receiver(skipped) {}
 
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
@@ -86,9 +87,9 @@ namespace MaNGOS
     struct ObjectMessageDeliverer
     {
         uint32 i_phaseMask;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         explicit ObjectMessageDeliverer(WorldObject const& obj, WorldPacket* msg)
-            : i_phaseMask(obj.GetPhaseMask()), i_message(msg) {}
+            : i_phaseMask(obj.GetPhaseMask()), i_message(*msg) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
     };
@@ -96,13 +97,13 @@ namespace MaNGOS
     struct MessageDistDeliverer
     {
         Player const& i_player;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         bool i_toSelf;
         bool i_ownTeamOnly;
         float i_dist;
 
         MessageDistDeliverer(Player const& pl, WorldPacket* msg, float dist, bool to_self, bool ownTeamOnly)
-            : i_player(pl), i_message(msg), i_toSelf(to_self), i_ownTeamOnly(ownTeamOnly), i_dist(dist) {}
+            : i_player(pl), i_message(*msg), i_toSelf(to_self), i_ownTeamOnly(ownTeamOnly), i_dist(dist) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
     };
@@ -110,9 +111,9 @@ namespace MaNGOS
     struct ObjectMessageDistDeliverer
     {
         WorldObject const& i_object;
-        WorldPacket* i_message;
+        SharedWorldPacket i_message;
         float i_dist;
-        ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket* msg, float dist) : i_object(obj), i_message(msg), i_dist(dist) {}
+        ObjectMessageDistDeliverer(WorldObject const& obj, WorldPacket* msg, float dist) : i_object(obj), i_message(*msg), i_dist(dist) {}
         void Visit(CameraMapType& m);
         template<class SKIP> void Visit(GridRefManager<SKIP> &) {}
     };
@@ -35,6 +35,9 @@
 #include "SharedDefines.h"
 #include "WorldSession.h"
 
+#include <algorithm>
+#include <iterator>
+
 INSTANTIATE_SINGLETON_1(LFGMgr);
 
 LFGMgr::LFGMgr()
@@ -51,6 +54,8 @@ LFGMgr::~LFGMgr()
 
     m_playerData.clear();
     m_queueSet.clear();
+    m_dungeonQueues.clear();
+    m_queueIndex.clear();
 
     m_playerStatusMap.clear();
     m_groupStatusMap.clear();
@@ -173,11 +178,7 @@ void LFGMgr::JoinLFG(uint32 roles, std::set<uint32> dungeons, std::string commen
         if (currentInfo->currentState == LFG_STATE_QUEUED)
         {
             // remove from that queue so they can later join this one
-            queueSet::iterator qItr = m_queueSet.find(guid);
-            if (qItr != m_queueSet.end())
-            {
-                m_queueSet.erase(qItr);
-            }
+            RemoveFromQueue(guid);
             // note: do we need to send a packet telling them the current queue is over?
         }
 
@@ -438,7 +439,7 @@ void LFGMgr::LeaveLFG(Player* plr, bool isGroup)
             }
         }
 
-        m_queueSet.erase(grpGuid);
+        RemoveFromQueue(grpGuid);
         m_playerData.erase(grpGuid);
     }
     else
@@ -457,7 +458,7 @@ void LFGMgr::LeaveLFG(Player* plr, bool isGroup)
             // do other states after being implemented, if applicable for a single plr
         }
 
-        m_queueSet.erase(plrGuid);
+        RemoveFromQueue(plrGuid);
         m_playerData.erase(plrGuid);
         m_playerStatusMap.erase(plrGuid);
     }
@@ -902,11 +903,15 @@ void LFGMgr::AddToQueue(ObjectGuid guid)
     {
         m_queueSet.insert(guid);
     }
+
+    // roles or dungeons may have changed, file it again
+    IndexQueueEntry(guid, information);
 }
 
 void LFGMgr::RemoveFromQueue(ObjectGuid guid)
 {
     m_queueSet.erase(guid);
+    UnindexQueueEntry(guid);
 
     //todo - might need to implement a removefromwaitmap function
 }
@@ -992,60 +997,189 @@ void LFGMgr::AddToWaitMap(uint8 role, std::set<uint32> dungeons)
 
 void LFGMgr::FindQueueMatches()
 {
-    // Fetch information on all the queued players/groups
-    for (queueSet::iterator itr = m_queueSet.begin(); itr != m_queueSet.end(); ++itr)
+    // the longest waiting players/groups pick their matches first
+    std::vector<std::pair<time_t, ObjectGuid> > waiting;
+    waiting.reserve(m_queueIndex.size());
+
+    for (queueIndexMap::const_iterator itr = m_queueIndex.begin(); itr != m_queueIndex.end(); ++itr)
     {
-        FindSpecificQueueMatches(*itr);
+        waiting.push_back(std::make_pair(itr->second.joinedTime, itr->first));
+    }
+
+    std::sort(waiting.begin(), waiting.end());
+
+    for (std::vector<std::pair<time_t, ObjectGuid> >::const_iterator itr = waiting.begin(); itr != waiting.end(); ++itr)
+    {
+        // skip the ones merged into a group earlier in this pass
+        if (m_queueIndex.find(itr->second) != m_queueIndex.end())
+        {
+            FindSpecificQueueMatches(itr->second);
+        }
     }
 }
 
 void LFGMgr::FindSpecificQueueMatches(ObjectGuid guid)
 {
-    uint64 rawGuid = guid.GetRawValue();
     LFGPlayers* queueInfo = GetPlayerOrPartyData(guid);
-    if (queueInfo)
+    ObjectGuid matchGuid;
+    std::set<uint32> compatibleDungeons;
+
+    // keep adding the longest waiting compatible player/group until the roles are filled
+    while (queueInfo && (queueInfo->neededTanks || queueInfo->neededHealers || queueInfo->neededDps) &&
+        FindQueueMatch(guid, queueInfo, matchGuid, compatibleDungeons))
     {
-        // compare to everyone else in queue for compatibility
-        // after a match is found call UpdateNeededRoles
-        // Use the roleMap to store player guid/role information; merge into queueInfo struct & delete other struct/map entry
-        for (queueSet::iterator itr = m_queueSet.begin(); itr != m_queueSet.end(); ++itr)
+        MergeGroups(guid, matchGuid, compatibleDungeons);
+        queueInfo = GetPlayerOrPartyData(guid);
+    }
+}
+
+bool LFGMgr::FindQueueMatch(ObjectGuid guid, LFGPlayers* queueInfo, ObjectGuid& matchGuid, std::set<uint32>& compatibleDungeons)
+{
+    queueIndexMap::const_iterator index = m_queueIndex.find(guid);
+    if (index == m_queueIndex.end())
+    {
+        return false;
+    }
+
+    // only the buckets of the same team that don't bring more of a role than is missing can match
+    uint8 teamBucket = index->second.bucket - index->second.bucket % LFG_ROLE_BUCKETS_PER_TEAM;
+    bool found = false;
+    time_t matchTime = 0;
+
+    for (std::set<uint32>::const_iterator dItr = queueInfo->dungeonList.begin(); dItr != queueInfo->dungeonList.end(); ++dItr)
+    {
+        dungeonQueueMap::const_iterator dungeon = m_dungeonQueues.find(*dItr);
+        if (dungeon == m_dungeonQueues.end())
         {
-            if (*itr == guid)
-            {
-                continue;
-            }
+            continue;
+        }
 
-            LFGPlayers* matchInfo = GetPlayerOrPartyData(*itr);
-            if (matchInfo)
+        for (uint8 tanks = 0; tanks <= queueInfo->neededTanks; ++tanks)
+        {
+            for (uint8 healers = 0; healers <= queueInfo->neededHealers; ++healers)
             {
-                // 1. iterate through queueInfo's dungeon set and search the matchInfo for a matching entry.
-                // 2. if an(y) entry is found, great and proceed!
-                // 2a. if an entry is found and the amounts of players-to-roles are compatible, make
-                //     a new map of only the inter-compatible dungeons and use that if the other checks pass
-                // 3. Regardless of outcome, after the end of calculations send a LFGQueueStatus packet
-                bool fullyCompatible = false;
-                std::set<uint32> compatibleDungeons;
-
-                for (std::set<uint32>::iterator dItr = matchInfo->dungeonList.begin(); dItr != matchInfo->dungeonList.end(); ++itr)
+                for (uint8 dps = 0; dps <= queueInfo->neededDps; ++dps)
                 {
-                    if (queueInfo->dungeonList.find(*dItr) != queueInfo->dungeonList.end())
-                    {
-                        compatibleDungeons.insert(*dItr);
-                    }
-                }
+                    uint8 bucket = teamBucket + (tanks * (NORMAL_TANK_OR_HEALER_COUNT + 1) + healers) * (NORMAL_DAMAGE_COUNT + 1) + dps;
+                    queueBucket const& candidates = dungeon->second.buckets[bucket];
 
-                if (!compatibleDungeons.empty())
-                {
-                    // check for player / role count and also team compatibility
-                    // if function returns true, then merge groups into one
-                    if (RoleMapsAreCompatible(queueInfo, matchInfo) && MatchesAreOfSameTeam(queueInfo, matchInfo))
+                    for (queueBucket::const_iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
                     {
-                        MergeGroups(guid, *itr, compatibleDungeons);
+                        // a match waiting longer was already found
+                        if (found && itr->first >= matchTime)
+                        {
+                            break;
+                        }
+
+                        if (itr->second == guid)
+                        {
+                            continue;
+                        }
+
+                        LFGPlayers* matchInfo = GetPlayerOrPartyData(itr->second);
+                        if (!matchInfo || !RoleMapsAreCompatible(queueInfo, matchInfo))
+                        {
+                            continue;
+                        }
+
+                        found = true;
+                        matchTime = itr->first;
+                        matchGuid = itr->second;
+                        break;
                     }
                 }
             }
         }
     }
+
+    if (!found)
+    {
+        return false;
+    }
+
+    LFGPlayers* matchInfo = GetPlayerOrPartyData(matchGuid);
+
+    compatibleDungeons.clear();
+    std::set_intersection(queueInfo->dungeonList.begin(), queueInfo->dungeonList.end(),
+        matchInfo->dungeonList.begin(), matchInfo->dungeonList.end(),
+        std::inserter(compatibleDungeons, compatibleDungeons.end()));
+
+    return true;
+}
+
+uint8 LFGMgr::GetQueueBucket(LFGPlayers* information)
+{
+    // a role that is over filled can never be matched
+    if (information->neededTanks > NORMAL_TANK_OR_HEALER_COUNT || information->neededHealers > NORMAL_TANK_OR_HEALER_COUNT ||
+        information->neededDps > NORMAL_DAMAGE_COUNT || information->currentRoles.empty())
+    {
+        return LFG_QUEUE_BUCKET_NONE;
+    }
+
+    // everyone in a player/group is on the same team, so any player decides it
+    Player* pPlayer = ObjectAccessor::FindPlayer(information->currentRoles.begin()->first);
+    if (!pPlayer)
+    {
+        return LFG_QUEUE_BUCKET_NONE;
+    }
+
+    uint8 tanks = NORMAL_TANK_OR_HEALER_COUNT - information->neededTanks;
+    uint8 healers = NORMAL_TANK_OR_HEALER_COUNT - information->neededHealers;
+    uint8 dps = NORMAL_DAMAGE_COUNT - information->neededDps;
+
+    return pPlayer->GetTeamId() * LFG_ROLE_BUCKETS_PER_TEAM + (tanks * (NORMAL_TANK_OR_HEALER_COUNT + 1) + healers) * (NORMAL_DAMAGE_COUNT + 1) + dps;
+}
+
+void LFGMgr::IndexQueueEntry(ObjectGuid guid, LFGPlayers* information)
+{
+    UnindexQueueEntry(guid);
+
+    uint8 bucket = GetQueueBucket(information);
+    if (bucket == LFG_QUEUE_BUCKET_NONE)
+    {
+        return;
+    }
+
+    LFGQueueIndex& index = m_queueIndex[guid];
+    index.dungeonList = information->dungeonList;
+    index.joinedTime = information->joinedTime;
+    index.bucket = bucket;
+
+    for (std::set<uint32>::const_iterator itr = index.dungeonList.begin(); itr != index.dungeonList.end(); ++itr)
+    {
+        m_dungeonQueues[*itr].buckets[bucket].insert(queueBucket::value_type(index.joinedTime, guid));
+    }
+}
+
+void LFGMgr::UnindexQueueEntry(ObjectGuid guid)
+{
+    queueIndexMap::iterator index = m_queueIndex.find(guid);
+    if (index == m_queueIndex.end())
+    {
+        return;
+    }
+
+    for (std::set<uint32>::const_iterator itr = index->second.dungeonList.begin(); itr != index->second.dungeonList.end(); ++itr)
+    {
+        dungeonQueueMap::iterator dungeon = m_dungeonQueues.find(*itr);
+        if (dungeon == m_dungeonQueues.end())
+        {
+            continue;
+        }
+
+        queueBucket& candidates = dungeon->second.buckets[index->second.bucket];
+        std::pair<queueBucket::iterator, queueBucket::iterator> range = candidates.equal_range(index->second.joinedTime);
+        for (queueBucket::iterator bItr = range.first; bItr != range.second; ++bItr)
+        {
+            if (bItr->second == guid)
+            {
+                candidates.erase(bItr);
+                break;
+            }
+        }
+    }
+
+    m_queueIndex.erase(index);
 }
 
 bool LFGMgr::RoleMapsAreCompatible(LFGPlayers* groupOne, LFGPlayers* groupTwo)
@@ -1079,26 +1213,6 @@ bool LFGMgr::RoleMapsAreCompatible(LFGPlayers* groupOne, LFGPlayers* groupTwo)
     return false;
 }
 
-bool LFGMgr::MatchesAreOfSameTeam(LFGPlayers* groupOne, LFGPlayers* groupTwo)
-{
-    // we should safely be able to compare any two players from each struct to
-    // determine compatibility
-    roleMap::iterator it1 = groupOne->currentRoles.begin();
-    roleMap::iterator it2 = groupTwo->currentRoles.begin();
-
-    // now we find the players from the maps
-    Player* pPlayer1 = ObjectAccessor::FindPlayer(it1->first);
-    Player* pPlayer2 = ObjectAccessor::FindPlayer(it2->first);
-
-    // todo: disable this if a config option is set
-    if (pPlayer1->GetTeamId() == pPlayer2->GetTeamId())
-    {
-        return true;
-    }
-
-    return false;
-}
-
 void LFGMgr::MergeGroups(ObjectGuid guidOne, ObjectGuid guidTwo, std::set<uint32> compatibleDungeons)
 {
     // merge into the entry for rawGuidOne, then see if they are
@@ -1124,6 +1238,10 @@ void LFGMgr::MergeGroups(ObjectGuid guidOne, ObjectGuid guidTwo, std::set<uint32
     // update the role count / needed role info
     UpdateNeededRoles(guidOne, mainGroup);
 
+    // the merged player/group is part of mainGroup now, mainGroup has new roles and dungeons
+    RemoveFromQueue(guidTwo);
+    IndexQueueEntry(guidOne, mainGroup);
+
     // being safe
     //mainGroup = GetPlayerOrPartyData(rawGuidOne);
 
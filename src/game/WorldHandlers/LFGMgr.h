@@ -28,6 +28,7 @@
 #include "Common.h"
 #include "Policies/Singleton.h"
 #include "Group.h"
+#include <map>
 #include <set>
 #include <vector>
 
@@ -40,6 +41,8 @@ struct LFGBoot;
 struct LFGGroupStatus;
 struct LFGPlayers;
 struct LFGPlayerStatus;
+struct LFGQueueBuckets;
+struct LFGQueueIndex;
 struct LFGProposal;
 struct LFGRoleCheck;
 struct LFGWait;
@@ -233,9 +236,15 @@ const int32 QUEUE_DEFAULT_TIME = 15*MINUTE;                              // 15 m
 /// Amount of votes needed to kick a player out of a group
 const int32 REQUIRED_VOTES_FOR_BOOT = 3;
 
+/// Queued players/groups are filed by team and by the tanks, healers and dps they already have
+const uint8 LFG_ROLE_BUCKETS_PER_TEAM = (NORMAL_TANK_OR_HEALER_COUNT + 1) * (NORMAL_TANK_OR_HEALER_COUNT + 1) * (NORMAL_DAMAGE_COUNT + 1);
+const uint8 LFG_QUEUE_BUCKET_COUNT    = PVP_TEAM_COUNT * LFG_ROLE_BUCKETS_PER_TEAM;
+const uint8 LFG_QUEUE_BUCKET_NONE     = LFG_QUEUE_BUCKET_COUNT;         // can't be matched with anyone
+
 typedef std::set<uint32> dailyEntries;                                   // for players who did one of X type instance per day
 typedef std::set<ObjectGuid> queueSet;                                   // List of players / groups in the queue
 typedef std::set<ObjectGuid> groupSet;                                   // List of groups doing a dungeon via the finder
+typedef std::multimap<time_t, ObjectGuid> queueBucket;                   // Time joined, ObjectGuid of plr/group (longest waiting first)
 
 typedef UNORDERED_MAP<uint32, uint32> dungeonEntries;                    // ID, Entry
 typedef UNORDERED_MAP<uint32, uint32> dungeonForbidden;                  // Entry, LFGForbiddenTypes
@@ -250,6 +259,8 @@ typedef UNORDERED_MAP<ObjectGuid, LFGProposalAnswer> proposalAnswerMap;  // Obje
 typedef UNORDERED_MAP<ObjectGuid, ObjectGuid> playerGroupMap;            // ObjectGuid of player, ObjectGuid of group
 typedef UNORDERED_MAP<ObjectGuid, LFGGroupStatus> groupStatusMap;        // ObjectGuid of group, group status structure
 typedef UNORDERED_MAP<ObjectGuid, LFGBoot> bootStatusMap;                // ObjectGuid of group, boot vote status
+typedef UNORDERED_MAP<uint32, LFGQueueBuckets> dungeonQueueMap;          // DungeonID, queued players/groups by team and roles
+typedef UNORDERED_MAP<ObjectGuid, LFGQueueIndex> queueIndexMap;          // ObjectGuid of plr/group, where it is filed in the dungeonQueueMap
 
 // End Section: Constants & Definitions
 
@@ -286,6 +297,20 @@ struct LFGPlayers //TODO: rename to LFGQueueData
         neededHealers(NeededHealers), neededDps(NeededDps) {}
 };
 
+/// Queued players/groups of one dungeon, bucketed by team and the roles they already have
+struct LFGQueueBuckets
+{
+    queueBucket buckets[LFG_QUEUE_BUCKET_COUNT];
+};
+
+/// Where a queued player/group is filed in the dungeon buckets
+struct LFGQueueIndex
+{
+    std::set<uint32> dungeonList; // The dungeons it is filed under
+    time_t joinedTime;            // Its key inside the buckets
+    uint8 bucket;                 // Team and role bucket
+};
+
 struct LFGRoleCheck
 {
     LFGRoleCheckState state;      // current status of the role check
@@ -616,8 +641,25 @@ protected:
     /// Compares two groups/players to see if their role combinations are compatible
     bool RoleMapsAreCompatible(LFGPlayers* groupOne, LFGPlayers* groupTwo);
 
-    /// Checks whether or not two combinations of players/groups are on the same team (alliance/horde)
-    bool MatchesAreOfSameTeam(LFGPlayers* groupOne, LFGPlayers* groupTwo);
+    /// Get the team and role bucket of a player/group, LFG_QUEUE_BUCKET_NONE if it can't be matched
+    uint8 GetQueueBucket(LFGPlayers* information);
+
+    /// File a queued player/group under its dungeons, replacing the previous entry
+    void IndexQueueEntry(ObjectGuid guid, LFGPlayers* information);
+
+    /// Remove a player/group from the dungeon buckets
+    void UnindexQueueEntry(ObjectGuid guid);
+
+    /**
+     * @brief Find the longest waiting player/group that fits the roles still missing in a group.
+     *
+     * @param guid The player or group's guid
+     * @param queueInfo Its queue information
+     * @param matchGuid Set to the guid of the match
+     * @param compatibleDungeons Set to the dungeons both of them queued for
+     * @return true if a match was found
+     */
+    bool FindQueueMatch(ObjectGuid guid, LFGPlayers* queueInfo, ObjectGuid& matchGuid, std::set<uint32>& compatibleDungeons);
 
     /// Are the players in a proposal already grouped up?
     bool IsProposalSameGroup(LFGProposal const& proposal);
@@ -672,6 +714,10 @@ private:
     playerData m_playerData;
     queueSet   m_queueSet;
 
+    /// Queued players/groups by dungeon, team and roles, used to find matches
+    dungeonQueueMap m_dungeonQueues;
+    queueIndexMap   m_queueIndex;
+
     /// Dungeon Finder Status for players
     playerStatusMap m_playerStatusMap;
 
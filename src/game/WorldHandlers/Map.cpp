@@ -46,6 +46,7 @@
 #include "Calendar.h"
 #include "Chat.h"
 #include "Weather.h"
+#include "PathFinder.h"
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
 #endif /* ENABLE_ELUNA */
@@ -87,6 +88,9 @@ Map::~Map()
 
     delete m_weatherSystem;
     m_weatherSystem = NULL;
+
+    delete m_pathCache;
+    m_pathCache = NULL;
 }
 
 void Map::LoadMapAndVMap(int gx, int gy)
@@ -133,6 +137,7 @@ Map::Map(uint32 id, time_t expiry, uint32 InstanceId, uint8 SpawnMode)
     m_persistentState->SetUsedByMapState(this);
 
     m_weatherSystem = new WeatherSystem(this);
+    m_pathCache = new PathCache(this);
 #ifdef ENABLE_ELUNA
     sEluna->OnCreate(this);
 #endif /* ENABLE_ELUNA */
@@ -506,6 +511,7 @@ bool Map::loaded(const GridPair& p) const
 void Map::Update(const uint32& t_diff)
 {
     m_dyn_tree.update(t_diff);
+    m_pathCache->NewTick();
 
     /// update worldsessions for existing players
     for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
@@ -680,6 +686,7 @@ void Map::Remove(Player* player, bool remove)
         m_mapRefIter = m_mapRefIter->nocheck_prev();
     }
     player->GetMapRef().unlink();
+    i_playerUpdateData.erase(player);
     CellPair p = MaNGOS::ComputeCellPair(player->GetPositionX(), player->GetPositionY());
     if (p.x_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP || p.y_coord >= TOTAL_NUMBER_OF_CELLS_PER_MAP)
     {
@@ -2146,23 +2153,49 @@ WorldObject* Map::GetWorldObject(ObjectGuid guid)
     return NULL;
 }
 
-void Map::SendObjectUpdates()
+void Map::AddUpdateObject(Object* obj)
 {
-    UpdateDataMapType update_players;
+    obj->SetClientUpdateIndex(i_objectsToClientUpdate.size());
+    i_objectsToClientUpdate.push_back(obj);
+}
 
+void Map::RemoveUpdateObject(Object* obj)
+{
+    uint32 index = obj->GetClientUpdateIndex();
+    if (index >= i_objectsToClientUpdate.size() || i_objectsToClientUpdate[index] != obj)
+    {
+        return;
+    }
+
+    // move the last object into the gap
+    Object* last = i_objectsToClientUpdate.back();
+    i_objectsToClientUpdate[index] = last;
+    last->SetClientUpdateIndex(index);
+    i_objectsToClientUpdate.pop_back();
+}
+
+void Map::SendObjectUpdates()
+{
     while (!i_objectsToClientUpdate.empty())
     {
-        Object* obj = *i_objectsToClientUpdate.begin();
-        i_objectsToClientUpdate.erase(i_objectsToClientUpdate.begin());
-        obj->BuildUpdateData(update_players);
+        Object* obj = i_objectsToClientUpdate.back();
+        i_objectsToClientUpdate.pop_back();
+        obj->BuildUpdateData(i_playerUpdateData);
     }
 
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    for (UpdateDataMapType::iterator iter = i_playerUpdateData.begin(); iter != i_playerUpdateData.end(); ++iter)
     {
+        // players without changes this tick only keep their buffer
+        if (!iter->second.HasData())
+        {
+            continue;
+        }
+
         iter->second.BuildPacket(&packet);
         iter->first->GetSession()->SendPacket(&packet);
         packet.clear();                                     // clean the string
+        iter->second.Clear();
     }
 }
 
@@ -2403,6 +2436,19 @@ float Map::GetHeight(uint32 phasemask, float x, float y, float z) const
     return std::max<float>(staticHeight, m_dyn_tree.getHeight(x, y, dynSearchHeight, dynSearchHeight - staticHeight, phasemask));
 }
 
+// GetHeight() for count points, the static heights are looked up in one batch
+void Map::GetHeights(uint32 phasemask, uint32 count, float const* x, float const* y, float const* z, float* heights) const
+{
+    m_TerrainData->GetHeightsStatic(count, x, y, z, heights);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float staticHeight = heights[i];
+        float dynSearchHeight = 2.0f + (z[i] < staticHeight ? staticHeight : z[i]);
+        heights[i] = std::max<float>(staticHeight, m_dyn_tree.getHeight(x[i], y[i], dynSearchHeight, dynSearchHeight - staticHeight, phasemask));
+    }
+}
+
 void Map::InsertGameObjectModel(const GameObjectModel& mdl)
 {
     m_dyn_tree.insert(mdl);
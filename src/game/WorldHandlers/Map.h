@@ -63,6 +63,7 @@ class BattleGround;
 class GridMap;
 class GameObjectModel;
 class WeatherSystem;
+class PathCache;
 
 // GCC have alternative #pragma pack(N) syntax and old gcc version not support pack(push,N), also any gcc version not support it at some platform
 #if defined( __GNUC__ )
@@ -262,15 +263,8 @@ class Map : public GridRefManager<NGridType>
         typedef TypeUnorderedMapContainer<AllMapStoredObjectTypes, ObjectGuid> MapStoredObjectTypesContainer;
         MapStoredObjectTypesContainer& GetObjectsStore() { return m_objectsStore; }
 
-        void AddUpdateObject(Object* obj)
-        {
-            i_objectsToClientUpdate.insert(obj);
-        }
-
-        void RemoveUpdateObject(Object* obj)
-        {
-            i_objectsToClientUpdate.erase(obj);
-        }
+        void AddUpdateObject(Object* obj);
+        void RemoveUpdateObject(Object* obj);
 
         // DynObjects currently
         uint32 GenerateLocalLowGuid(HighGuid guidhigh);
@@ -288,6 +282,7 @@ class Map : public GridRefManager<NGridType>
 
         // Dynamic VMaps
         float GetHeight(uint32 phasemask, float x, float y, float z) const;
+        void GetHeights(uint32 phasemask, uint32 count, float const* x, float const* y, float const* z, float* heights) const;
         bool GetHeightInRange(uint32 phasemask, float x, float y, float& z, float maxSearchDist = 4.0f) const;
         bool IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask) const;
         bool GetHitPosition(float srcX, float srcY, float srcZ, float& destX, float& destY, float& destZ, uint32 phasemask, float modifyDist) const;
@@ -318,6 +313,9 @@ class Map : public GridRefManager<NGridType>
          */
         void SetWeather(uint32 zoneId, WeatherType type, float grade, bool permanently);
 
+        // poly paths found by units of this map during the current update
+        PathCache* GetPathCache() const { return m_pathCache; }
+
 
     private:
         void LoadMapAndVMap(int gx, int gy);
@@ -355,7 +353,8 @@ class Map : public GridRefManager<NGridType>
         void ScriptsProcess();
 
         void SendObjectUpdates();
-        std::set<Object*> i_objectsToClientUpdate;
+        std::vector<Object*> i_objectsToClientUpdate;       // objects keep their index in it, see Object::GetClientUpdateIndex
+        UpdateDataMapType i_playerUpdateData;               // per player update buffers, reused every tick
 
     protected:
         MapEntry const* i_mapEntry;
@@ -414,6 +413,9 @@ class Map : public GridRefManager<NGridType>
 
         // WeatherSystem
         WeatherSystem* m_weatherSystem;
+
+        // Path finding results shared within one update
+        PathCache* m_pathCache;
 };
 
 class WorldMap : public Map
@@ -33,6 +33,7 @@
 #include "CellImpl.h"
 #include "Corpse.h"
 #include "ObjectMgr.h"
+#include "MoveMap.h"
 
 #define CLASS_LOCK MaNGOS::ClassLevelLockable<MapManager, ACE_Recursive_Thread_Mutex>
 INSTANTIATE_SINGLETON_2(MapManager, CLASS_LOCK);
@@ -63,6 +64,22 @@ void
 MapManager::Initialize()
 {
     InitStateMachine();
+
+    uint32 num_threads = sWorld.getConfig(CONFIG_UINT32_MAPUPDATE_THREADS);
+    if (num_threads > 1)
+    {
+        // the mmap manager is created on first use, which must not race between map update threads
+        MMAP::MMapFactory::createOrGetMMapManager();
+
+        if (m_updater.activate(num_threads) == -1)
+        {
+            sLog.outError("MapManager: failed to start %u map update threads, maps will be updated on the world thread", num_threads);
+        }
+        else
+        {
+            sLog.outString("MapManager: using %u map update threads", num_threads);
+        }
+    }
 }
 
 void MapManager::InitStateMachine()
@@ -191,9 +208,38 @@ void MapManager::Update(uint32 diff)
         return;
     }
 
-    for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+    if (m_updater.activated())
     {
-        iter->second->Update((uint32)i_timer.GetCurrent());
+        // instances of one map id share their vmap tree and nav mesh, so they are updated one after another by the same worker
+        MapMapType::iterator iter = i_maps.begin();
+        while (iter != i_maps.end())
+        {
+            std::vector<Map*> maps;
+            uint32 mapId = iter->first.nMapId;
+            for (; iter != i_maps.end() && iter->first.nMapId == mapId; ++iter)
+            {
+                maps.push_back(iter->second);
+            }
+
+            // do not skip the tick of maps the pool did not take
+            if (m_updater.schedule_update(maps, (uint32)i_timer.GetCurrent()) == -1)
+            {
+                for (std::vector<Map*>::const_iterator itr = maps.begin(); itr != maps.end(); ++itr)
+                {
+                    (*itr)->Update((uint32)i_timer.GetCurrent());
+                }
+            }
+        }
+
+        // all maps must have finished their tick before transports and map unloading touch them
+        m_updater.wait();
+    }
+    else
+    {
+        for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+        {
+            iter->second->Update((uint32)i_timer.GetCurrent());
+        }
     }
 
     for (TransportSet::iterator iter = m_Transports.begin(); iter != m_Transports.end(); ++iter)
@@ -251,6 +297,11 @@ bool MapManager::IsValidMAP(uint32 mapid)
 
 void MapManager::UnloadAll()
 {
+    if (m_updater.activated())
+    {
+        m_updater.deactivate();
+    }
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end(); ++iter)
     {
         iter->second->UnloadAll(true);
@@ -0,0 +1,150 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2021 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "MapUpdater.h"
+#include "Map.h"
+#include "Log.h"
+#include "Database/DatabaseEnv.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+
+class MapUpdateRequest : public ACE_Method_Request
+{
+    private:
+        std::vector<Map*> m_maps;
+        MapUpdater& m_updater;
+        uint32 m_diff;
+
+    public:
+        MapUpdateRequest(std::vector<Map*> const& m, MapUpdater& u, uint32 d)
+            : m_maps(m), m_updater(u), m_diff(d)
+        {
+        }
+
+        virtual int call()
+        {
+            for (std::vector<Map*>::const_iterator itr = m_maps.begin(); itr != m_maps.end(); ++itr)
+            {
+                (*itr)->Update(m_diff);
+            }
+
+            m_updater.update_finished();
+            return 0;
+        }
+};
+
+/// Map updates query and execute on the databases directly, so every worker needs its own client library thread state
+class MapUpdaterThreadStart : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            WorldDatabase.ThreadStart();
+            CharacterDatabase.ThreadStart();
+            return 0;
+        }
+};
+
+class MapUpdaterThreadEnd : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            CharacterDatabase.ThreadEnd();
+            WorldDatabase.ThreadEnd();
+            return 0;
+        }
+};
+
+MapUpdater::MapUpdater()
+    : m_executor(), m_mutex(), m_condition(m_mutex), m_pending_requests(0)
+{
+}
+
+MapUpdater::~MapUpdater()
+{
+    deactivate();
+}
+
+int MapUpdater::activate(size_t num_threads)
+{
+    return m_executor.activate((int)num_threads, new MapUpdaterThreadStart, new MapUpdaterThreadEnd);
+}
+
+int MapUpdater::deactivate()
+{
+    wait();
+
+    return m_executor.deactivate();
+}
+
+int MapUpdater::wait()
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+    while (m_pending_requests > 0)
+    {
+        m_condition.wait();
+    }
+
+    return 0;
+}
+
+int MapUpdater::schedule_update(std::vector<Map*> const& maps, uint32 diff)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, -1);
+
+    ++m_pending_requests;
+
+    if (m_executor.execute(new MapUpdateRequest(maps, *this, diff)) == -1)
+    {
+        sLog.outError("MapUpdater::schedule_update: failed to queue update for map %u", maps.empty() ? 0 : maps.front()->GetId());
+
+        --m_pending_requests;
+        return -1;
+    }
+
+    return 0;
+}
+
+bool MapUpdater::activated()
+{
+    return m_executor.activated();
+}
+
+void MapUpdater::update_finished()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    if (m_pending_requests == 0)
+    {
+        sLog.outError("MapUpdater::update_finished: pending requests counter is already 0");
+        return;
+    }
+
+    --m_pending_requests;
+
+    m_condition.broadcast();
+}
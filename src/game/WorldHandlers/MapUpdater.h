@@ -0,0 +1,96 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2021 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_MAPUPDATER
+#define MANGOS_H_MAPUPDATER
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include "Common.h"
+#include "DelayExecutor.h"
+
+#include <vector>
+
+class Map;
+
+/**
+ * @brief Thread pool running Map::Update for independent maps concurrently.
+ *
+ * The world thread schedules one request per map and then blocks in wait()
+ * until every map has finished its tick, so everything executed after the
+ * barrier (object removal, transports, battleground manager) still sees a
+ * consistent world.
+ */
+class MapUpdater
+{
+    public:
+        MapUpdater();
+        virtual ~MapUpdater();
+
+        friend class MapUpdateRequest;
+
+        /**
+         * @brief start the worker threads
+         *
+         * @param num_threads
+         * @return int -1 on failure
+         */
+        int activate(size_t num_threads);
+
+        /**
+         * @brief wait for pending updates and stop the worker threads
+         *
+         * @return int -1 on failure
+         */
+        int deactivate();
+
+        /**
+         * @brief block until all scheduled map updates are done
+         *
+         * @return int
+         */
+        int wait();
+
+        /**
+         * @brief queue Map::Update(diff) of the maps for execution one after another on a worker thread
+         *
+         * @param maps
+         * @param diff
+         * @return int -1 on failure, the maps were not queued
+         */
+        int schedule_update(std::vector<Map*> const& maps, uint32 diff);
+
+        bool activated();
+
+    private:
+        DelayExecutor m_executor;
+        ACE_Thread_Mutex m_mutex;
+        ACE_Condition_Thread_Mutex m_condition;
+        size_t m_pending_requests;
+
+        void update_finished();
+};
+
+#endif
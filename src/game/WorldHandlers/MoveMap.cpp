@@ -157,10 +157,24 @@ namespace MMAP
         // if we had, tiles in MMapData->mmapLoadedTiles, their actual data is lost!
     }
 
+    MMapData* MMapManager::findMapData(uint32 mapId) const
+    {
+        std::lock_guard<std::mutex> lock(loadedMMapsLock);
+
+        MMapDataSet::const_iterator itr = loadedMMaps.find(mapId);
+        return itr != loadedMMaps.end() ? itr->second : NULL;
+    }
+
+    uint32 MMapManager::getLoadedMapsCount() const
+    {
+        std::lock_guard<std::mutex> lock(loadedMMapsLock);
+        return loadedMMaps.size();
+    }
+
     bool MMapManager::loadMapData(uint32 mapId)
     {
         // we already have this map loaded?
-        if (loadedMMaps.find(mapId) != loadedMMaps.end())
+        if (findMapData(mapId))
         {
             return true;
         }
@@ -203,6 +217,7 @@ namespace MMAP
         MMapData* mmap_data = new MMapData(mesh);
         mmap_data->mmapLoadedTiles.clear();
 
+        std::lock_guard<std::mutex> lock(loadedMMapsLock);
         loadedMMaps.insert(std::pair<uint32, MMapData*>(mapId, mmap_data));
         return true;
     }
@@ -221,7 +236,7 @@ namespace MMAP
         }
 
         // get this mmap data
-        MMapData* mmap = loadedMMaps[mapId];
+        MMapData* mmap = findMapData(mapId);
         MANGOS_ASSERT(mmap->navMesh);
 
         // check if we already have this tile loaded
@@ -298,15 +313,14 @@ namespace MMAP
     bool MMapManager::unloadMap(uint32 mapId, int32 x, int32 y)
     {
         // check if we have this map loaded
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        MMapData* mmap = findMapData(mapId);
+        if (!mmap)
         {
             // file may not exist, therefore not loaded
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Asked to unload not loaded navmesh map. %03u%02i%02i.mmtile", mapId, x, y);
             return false;
         }
 
-        MMapData* mmap = loadedMMaps[mapId];
-
         // check if we have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
         if (mmap->mmapLoadedTiles.find(packedGridPos) == mmap->mmapLoadedTiles.end())
@@ -340,7 +354,8 @@ namespace MMAP
 
     bool MMapManager::unloadMap(uint32 mapId)
     {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        MMapData* mmap = findMapData(mapId);
+        if (!mmap)
         {
             // file may not exist, therefore not loaded
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Asked to unload not loaded navmesh map %03u", mapId);
@@ -348,7 +363,6 @@ namespace MMAP
         }
 
         // unload all tiles from given map
-        MMapData* mmap = loadedMMaps[mapId];
         for (MMapTileSet::iterator i = mmap->mmapLoadedTiles.begin(); i != mmap->mmapLoadedTiles.end(); ++i)
         {
             uint32 x = (i->first >> 16);
@@ -364,8 +378,11 @@ namespace MMAP
             }
         }
 
+        {
+            std::lock_guard<std::mutex> lock(loadedMMapsLock);
+            loadedMMaps.erase(mapId);
+        }
         delete mmap;
-        loadedMMaps.erase(mapId);
         DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMap: Unloaded %03i.mmap", mapId);
 
         return true;
@@ -374,14 +391,13 @@ namespace MMAP
     bool MMapManager::unloadMapInstance(uint32 mapId, uint32 instanceId)
     {
         // check if we have this map loaded
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        MMapData* mmap = findMapData(mapId);
+        if (!mmap)
         {
             // file may not exist, therefore not loaded
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map %03u", mapId);
             return false;
         }
-
-        MMapData* mmap = loadedMMaps[mapId];
         if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
         {
             DEBUG_FILTER_LOG(LOG_FILTER_MAP_LOADING, "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId %03u instanceId %u", mapId, instanceId);
@@ -399,22 +415,18 @@ namespace MMAP
 
     dtNavMesh const* MMapManager::GetNavMesh(uint32 mapId)
     {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
-        {
-            return NULL;
-        }
-
-        return loadedMMaps[mapId]->navMesh;
+        MMapData* mmap = findMapData(mapId);
+        return mmap ? mmap->navMesh : NULL;
     }
 
     dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
     {
-        if (loadedMMaps.find(mapId) == loadedMMaps.end())
+        MMapData* mmap = findMapData(mapId);
+        if (!mmap)
         {
             return NULL;
         }
 
-        MMapData* mmap = loadedMMaps[mapId];
         if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
         {
             // allocate mesh query
@@ -31,6 +31,9 @@
 
 #include "Utilities/UnorderedMapSet.h"
 
+#include <atomic>
+#include <mutex>
+
 class Unit;
 
 //  memory management
@@ -79,6 +82,8 @@ namespace MMAP
 
     // singelton class
     // holds all all access to mmap loading unloading and meshes
+    // the MMapData of a map id is only used by the thread updating the maps of that id,
+    // only the map list itself is shared between threads
     class MMapManager
     {
         public:
@@ -95,13 +100,15 @@ namespace MMAP
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
             uint32 getLoadedTilesCount() const { return loadedTiles; }
-            uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
+            uint32 getLoadedMapsCount() const;
         private:
             bool loadMapData(uint32 mapId);
+            MMapData* findMapData(uint32 mapId) const;
             uint32 packTileID(int32 x, int32 y);
 
             MMapDataSet loadedMMaps;
-            uint32 loadedTiles;
+            mutable std::mutex loadedMMapsLock;     // guards loadedMMaps
+            std::atomic<uint32> loadedTiles;
     };
 
     // static class
@@ -0,0 +1,267 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2021 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "StartupLoader.h"
+#include "Database/DatabaseEnv.h"
+#include "DelayExecutor.h"
+#include "ProgressBar.h"
+#include "Timer.h"
+#include "Util.h"
+#include "Log.h"
+
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+
+class StartupLoadRequest : public ACE_Method_Request
+{
+    private:
+        StartupLoader& m_loader;
+        size_t m_index;
+
+    public:
+        StartupLoadRequest(StartupLoader& l, size_t i)
+            : m_loader(l), m_index(i)
+        {
+        }
+
+        virtual int call()
+        {
+            m_loader.Execute(m_index);
+            m_loader.StepFinished(m_index);
+            return 0;
+        }
+};
+
+/// Startup threads query the world database directly, so every one of them needs its own client library thread state
+class StartupThreadStart : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            WorldDatabase.ThreadStart();
+            return 0;
+        }
+};
+
+class StartupThreadEnd : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            WorldDatabase.ThreadEnd();
+            return 0;
+        }
+};
+
+StartupLoader::StartupLoader(char const* stageName)
+    : m_stageName(stageName), m_stageStart(0), m_mutex(), m_condition(m_mutex), m_finishedSteps(0), m_executor(NULL)
+{
+}
+
+StartupLoader::~StartupLoader()
+{
+}
+
+void StartupLoader::AddStep(char const* name, LoadFunction function, char const* dependsOn)
+{
+    Step step;
+    step.name = name;
+    step.function = function;
+    step.pendingDependencies = 0;
+    step.startTime = 0;
+    step.duration = 0;
+
+    size_t index = m_steps.size();
+
+    Tokens names = StrSplit(dependsOn, " ");
+    for (Tokens::const_iterator itr = names.begin(); itr != names.end(); ++itr)
+    {
+        if (itr->empty())
+        {
+            continue;
+        }
+
+        size_t dep = 0;
+        while (dep < index && m_steps[dep].name != *itr)
+        {
+            ++dep;
+        }
+
+        // dependencies must be declared first, which also keeps the graph acyclic
+        MANGOS_ASSERT(dep < index);
+
+        step.dependencies.push_back(dep);
+        ++step.pendingDependencies;
+        m_steps[dep].dependents.push_back(index);
+    }
+
+    m_steps.push_back(step);
+}
+
+void StartupLoader::Run(uint32 threads)
+{
+    if (m_steps.empty())
+    {
+        return;
+    }
+
+    m_stageStart = getMSTime();
+
+    if (threads <= 1 || m_steps.size() == 1 || !RunParallel(threads))
+    {
+        RunSequential();
+    }
+
+    LogReport(getMSTimeDiff(m_stageStart, getMSTime()));
+}
+
+void StartupLoader::RunSequential()
+{
+    for (size_t i = 0; i < m_steps.size(); ++i)
+    {
+        Execute(i);
+    }
+}
+
+bool StartupLoader::RunParallel(uint32 threads)
+{
+    DelayExecutor executor;
+    if (executor.activate(int(std::min<size_t>(threads, m_steps.size())), new StartupThreadStart, new StartupThreadEnd) == -1)
+    {
+        sLog.outError("StartupLoader: can't start %u threads for %s, loading sequentially", threads, m_stageName.c_str());
+        return false;
+    }
+
+    // progress bars of concurrent loaders would only garble each other
+    bool showProgress = BarGoLink::GetOutputState();
+    BarGoLink::SetOutputState(false);
+
+    {
+        ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_mutex, false);
+
+        m_executor = &executor;
+        m_finishedSteps = 0;
+
+        for (size_t i = 0; i < m_steps.size(); ++i)
+        {
+            if (m_steps[i].pendingDependencies == 0)
+            {
+                m_steps[i].pendingDependencies = uint32(-1);
+                executor.execute(new StartupLoadRequest(*this, i));
+            }
+        }
+
+        while (m_finishedSteps < m_steps.size())
+        {
+            m_condition.wait();
+        }
+
+        m_executor = NULL;
+    }
+
+    executor.deactivate();
+
+    BarGoLink::SetOutputState(showProgress);
+    return true;
+}
+
+void StartupLoader::Execute(size_t index)
+{
+    Step& step = m_steps[index];
+
+    uint32 start = getMSTime();
+    step.startTime = getMSTimeDiff(m_stageStart, start);
+
+    step.function();
+
+    step.duration = getMSTimeDiff(start, getMSTime());
+}
+
+void StartupLoader::StepFinished(size_t index)
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_mutex);
+
+    std::vector<size_t> const& dependents = m_steps[index].dependents;
+    for (std::vector<size_t>::const_iterator itr = dependents.begin(); itr != dependents.end(); ++itr)
+    {
+        Step& next = m_steps[*itr];
+        if (--next.pendingDependencies == 0)
+        {
+            next.pendingDependencies = uint32(-1);
+            m_executor->execute(new StartupLoadRequest(*this, *itr));
+        }
+    }
+
+    ++m_finishedSteps;
+    m_condition.broadcast();
+}
+
+void StartupLoader::LogReport(uint32 totalTime) const
+{
+    // earliest possible finish of every step with unlimited threads, the longest one ends the critical path
+    std::vector<uint32> finish(m_steps.size(), 0);
+    std::vector<size_t> previous(m_steps.size(), m_steps.size());
+    uint32 loaderTime = 0;
+    size_t last = 0;
+
+    for (size_t i = 0; i < m_steps.size(); ++i)
+    {
+        Step const& step = m_steps[i];
+
+        uint32 ready = 0;
+        for (std::vector<size_t>::const_iterator itr = step.dependencies.begin(); itr != step.dependencies.end(); ++itr)
+        {
+            if (finish[*itr] >= ready)
+            {
+                ready = finish[*itr];
+                previous[i] = *itr;
+            }
+        }
+
+        finish[i] = ready + step.duration;
+        loaderTime += step.duration;
+
+        if (finish[i] > finish[last])
+        {
+            last = i;
+        }
+    }
+
+    std::string path;
+    for (size_t i = last; i < m_steps.size(); i = previous[i])
+    {
+        path = path.empty() ? m_steps[i].name : m_steps[i].name + " -> " + path;
+    }
+
+    sLog.outString(">> %s: %u steps done in %u ms (sum of loaders %u ms, critical path %u ms)",
+                   m_stageName.c_str(), uint32(m_steps.size()), totalTime, loaderTime, finish[last]);
+    sLog.outString(">> Critical path: %s", path.c_str());
+
+    for (size_t i = 0; i < m_steps.size(); ++i)
+    {
+        DETAIL_LOG("    %-32s started at %6u ms, took %6u ms", m_steps[i].name.c_str(), m_steps[i].startTime, m_steps[i].duration);
+    }
+
+    sLog.outString();
+}
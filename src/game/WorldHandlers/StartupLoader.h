@@ -0,0 +1,104 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2021 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOS_H_STARTUPLOADER
+#define MANGOS_H_STARTUPLOADER
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include "Common.h"
+
+class DelayExecutor;
+
+/**
+ * @brief Runs a group of world startup loaders as a dependency graph.
+ *
+ * Every step may only depend on steps added before it, so the declaration
+ * order is always a valid sequential order. With a single thread the steps
+ * run one after another on the calling thread exactly as before; with more
+ * threads each step is queued on a startup thread pool as soon as all of its
+ * dependencies are done. Run() returns once every step has finished and logs
+ * a per-step timing report together with the critical path of the stage.
+ */
+class StartupLoader
+{
+    public:
+        typedef void (*LoadFunction)();
+
+        /**
+         * @brief
+         *
+         * @param stageName name used in the timing report
+         */
+        explicit StartupLoader(char const* stageName);
+        ~StartupLoader();
+
+        friend class StartupLoadRequest;
+
+        /**
+         * @brief declare a loader step
+         *
+         * @param name unique step name
+         * @param function loader to call
+         * @param dependsOn space separated names of previously added steps
+         */
+        void AddStep(char const* name, LoadFunction function, char const* dependsOn = "");
+
+        /**
+         * @brief execute all steps and wait for them to finish
+         *
+         * @param threads number of startup threads, 1 runs the steps in declaration order
+         */
+        void Run(uint32 threads);
+
+    private:
+        struct Step
+        {
+            std::string name;                   /**< step name */
+            LoadFunction function;              /**< loader */
+            std::vector<size_t> dependents;     /**< steps waiting for this one */
+            std::vector<size_t> dependencies;   /**< steps this one waits for */
+            uint32 pendingDependencies;         /**< dependencies not finished yet */
+            uint32 startTime;                   /**< ms since stage start */
+            uint32 duration;                    /**< ms spent in the loader */
+        };
+
+        void RunSequential();
+        bool RunParallel(uint32 threads);
+        void Execute(size_t index);
+        void StepFinished(size_t index);
+        void LogReport(uint32 totalTime) const;
+
+        std::string m_stageName;                /**< TODO */
+        std::vector<Step> m_steps;              /**< steps in declaration order */
+        uint32 m_stageStart;                    /**< getMSTime() at Run() */
+
+        ACE_Thread_Mutex m_mutex;               /**< guards m_finishedSteps and the pending counters */
+        ACE_Condition_Thread_Mutex m_condition; /**< signalled whenever a step finishes */
+        size_t m_finishedSteps;                 /**< TODO */
+        DelayExecutor* m_executor;              /**< startup thread pool, only set during a parallel run */
+};
+
+#endif
@@ -35,6 +35,7 @@
 #include "Opcodes.h"
 #include "WorldSession.h"
 #include "WorldPacket.h"
+#include "SharedWorldPacket.h"
 #include "Player.h"
 #include "SkillExtraItems.h"
 #include "SkillDiscovery.h"
@@ -43,6 +44,7 @@
 #include "ArenaTeam.h"
 #include "AuctionHouseMgr.h"
 #include "ObjectMgr.h"
+#include "SQLStorages.h"
 #include "CreatureEventAIMgr.h"
 #include "GuildMgr.h"
 #include "SpellMgr.h"
@@ -61,6 +63,7 @@
 #include "TemporarySummon.h"
 #include "VMapFactory.h"
 #include "MoveMap.h"
+#include "PathFinder.h"
 #include "GameEventMgr.h"
 #include "PoolManager.h"
 #include "Database/DatabaseImpl.h"
@@ -82,6 +85,7 @@
 #include "revision.h"
 #include "UpdateTime.h"
 #include "GameTime.h"
+#include "StartupLoader.h"
 
 #ifdef ENABLE_ELUNA
 #include "LuaEngine.h"
@@ -578,6 +582,7 @@ void World::LoadConfigSettings(bool reload)
     setConfig(CONFIG_BOOL_ADDON_CHANNEL, "AddonChannel", true);
     setConfig(CONFIG_BOOL_CLEAN_CHARACTER_DB, "CleanCharacterDB", true);
     setConfig(CONFIG_BOOL_GRID_UNLOAD, "GridUnload", true);
+    setConfig(CONFIG_BOOL_MAP_FILE_MMAP, "MapFiles.MemoryMapped", false);
     setConfig(CONFIG_UINT32_MAX_WHOLIST_RETURNS, "MaxWhoListReturns", 49);
 
     std::string forceLoadGridOnMaps = sConfig.GetStringDefault("LoadAllGridsOnMaps", "");
@@ -621,6 +626,16 @@ void World::LoadConfigSettings(bool reload)
         sMapMgr.SetMapUpdateInterval(getConfig(CONFIG_UINT32_INTERVAL_MAPUPDATE));
     }
 
+    if (configNoReload(reload, CONFIG_UINT32_MAPUPDATE_THREADS, "MapUpdate.Threads", 1))
+    {
+        setConfigMinMax(CONFIG_UINT32_MAPUPDATE_THREADS, "MapUpdate.Threads", 1, 1, 64);
+    }
+
+    if (configNoReload(reload, CONFIG_UINT32_STARTUP_THREADS, "Startup.Threads", 1))
+    {
+        setConfigMinMax(CONFIG_UINT32_STARTUP_THREADS, "Startup.Threads", 1, 1, 64);
+    }
+
     setConfig(CONFIG_UINT32_INTERVAL_CHANGEWEATHER, "ChangeWeatherInterval", 10 * MINUTE * IN_MILLISECONDS);
 
     if (configNoReload(reload, CONFIG_UINT32_PORT_WORLD, "WorldServerPort", DEFAULT_WORLDSERVER_PORT))
@@ -1006,6 +1021,8 @@ void World::LoadConfigSettings(bool reload)
         sLog.outString("Using DataDir %s", m_dataPath.c_str());
     }
 
+    SQLStorageBase::SetSnapshotDirectory(sConfig.GetStringDefault("SQLStorage.SnapshotDir", ""));
+
     setConfig(CONFIG_BOOL_VMAP_INDOOR_CHECK, "vmap.enableIndoorCheck", true);
     bool enableLOS = sConfig.GetBoolDefault("vmap.enableLOS", false);
     bool enableHeight = sConfig.GetBoolDefault("vmap.enableHeight", false);
@@ -1039,198 +1056,357 @@ void World::LoadConfigSettings(bool reload)
     sLog.outString();
 }
 
-/// Initialize the World
-void World::SetInitialWorldSettings()
+/// Startup loader steps, see the StartupLoader stages in World::SetInitialWorldSettings for their dependencies
+static void LoadStepDBCStores()
 {
-    ///- Initialize the random number generator
-    srand((unsigned int)time(NULL));
-
-    ///- Time server startup
-    uint32 startupBegin = GameTime::GetGameTimeMS();
-
-    ///- Initialize detour memory management
-    dtAllocSetCustom(dtCustomAlloc, dtCustomFree);
-
-    ///- Initialize config settings
-    LoadConfigSettings();
-
-    ///- Initialize VMapManager function pointers (to untangle game/collision circular deps)
-    if (VMAP::VMapManager2* vmmgr2 = dynamic_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager()))
-    {
-        //vmmgr2->GetLiquidFlagsPtr = &GetLiquidFlags;
-        vmmgr2->IsVMAPDisabledForPtr = &DisableMgr::IsVMAPDisabledFor;
-    }
-
-    ///- Check the existence of the map files for all races start areas.
-    if (!MapManager::ExistMapAndVMap(0, -6240.32f, 331.033f) ||                     // Dwarf/ Gnome
-        !MapManager::ExistMapAndVMap(0, -8949.95f, -132.493f) ||                // Human
-        !MapManager::ExistMapAndVMap(1, -618.518f, -4251.67f) ||                // Orc
-        !MapManager::ExistMapAndVMap(0, 1676.35f, 1677.45f) ||                  // Scourge
-        !MapManager::ExistMapAndVMap(1, 10311.3f, 832.463f) ||                  // NightElf
-        !MapManager::ExistMapAndVMap(1, -2917.58f, -257.98f) ||                 // Tauren
-        (m_configUint32Values[CONFIG_UINT32_EXPANSION] >= EXPANSION_TBC &&
-          (!MapManager::ExistMapAndVMap(530, 10349.6f, -6357.29f) ||            // BloodElf
-              !MapManager::ExistMapAndVMap(530, -3961.64f, -13931.2f))) ||          // Draenei
-            (m_configUint32Values[CONFIG_UINT32_EXPANSION] >= EXPANSION_WOTLK &&
-              !MapManager::ExistMapAndVMap(609, 2355.84f, -5664.77f)))              // Death Knight
-    {
-        sLog.outError("Correct *.map files not found in path '%smaps' or *.vmtree/*.vmtile files in '%svmaps'. Please place *.map and vmap files in appropriate directories or correct the DataDir value in the mangosd.conf file.", m_dataPath.c_str(), m_dataPath.c_str());
-        Log::WaitBeforeContinueIfNeed();
-        exit(1);
-    }
-
-    ///- Loading strings. Getting no records means core load has to be canceled because no error message can be output.
-    sLog.outString();
-    sLog.outString("Loading MaNGOS strings...");
-    if (!sObjectMgr.LoadMangosStrings())
-    {
-        Log::WaitBeforeContinueIfNeed();
-        exit(1);                                            // Error message displayed in function already
-    }
-
-    ///- Update the realm entry in the database with the realm type from the config file
-    // No SQL injection as values are treated as integers
-
-    // not send custom type REALM_FFA_PVP to realm list
-    uint32 server_type = IsFFAPvPRealm() ? uint32(REALM_TYPE_PVP) : getConfig(CONFIG_UINT32_GAME_TYPE);
-    uint32 realm_zone = getConfig(CONFIG_UINT32_REALM_ZONE);
-    LoginDatabase.PExecute("UPDATE `realmlist` SET `icon` = %u, `timezone` = %u WHERE `id` = '%u'", server_type, realm_zone, realmID);
-
-    ///- Remove the bones (they should not exist in DB though) and old corpses after a restart
-    CharacterDatabase.PExecute("DELETE FROM `corpse` WHERE `corpse_type` = '0' OR `time` < (UNIX_TIMESTAMP()-'%u')", 3 * DAY);
-
-    ///- Load the DBC files
     sLog.outString("Initialize DBC data stores...");
-    LoadDBCStores(m_dataPath);
-    DetectDBCLang();
-    sObjectMgr.SetDBCLocaleIndex(GetDefaultDbcLocale());    // Get once for all the locale index of DBC language (console/broadcasts)
-    LoadDB2Stores(m_dataPath);
+    LoadDBCStores(sWorld.GetDataPath());
+}
+
+static void LoadStepDB2Stores()
+{
+    LoadDB2Stores(sWorld.GetDataPath());
+}
 
+static void LoadStepSpellTemplate()
+{
     sLog.outString("Loading SpellTemplate...");
     sObjectMgr.LoadSpellTemplate();
+}
 
+static void LoadStepScriptNames()
+{
     sLog.outString("Loading Script Names...");
     sScriptMgr.LoadScriptNames();
+}
 
+static void LoadStepInstanceTemplate()
+{
     sLog.outString("Loading InstanceTemplate...");
     sObjectMgr.LoadInstanceTemplate();
+}
 
+static void LoadStepSkillLineAbilityMap()
+{
     sLog.outString("Loading SkillLineAbilityMultiMap Data...");
     sSpellMgr.LoadSkillLineAbilityMap();
+}
 
+static void LoadStepSkillRaceClassInfoMap()
+{
     sLog.outString("Loading SkillRaceClassInfoMultiMap Data...");
     sSpellMgr.LoadSkillRaceClassInfoMap();
+}
 
-    ///- Clean up and pack instances
-    sLog.outString("Cleaning up instances...");
-    sMapPersistentStateMgr.CleanupInstances();              // must be called before `creature_respawn`/`gameobject_respawn` tables
-
-    sLog.outString("Packing instances...");
-    sMapPersistentStateMgr.PackInstances();
-
-    sLog.outString("Packing groups...");
-    sObjectMgr.PackGroupIds();                              // must be after CleanupInstances
-
-    ///- Init highest guids before any guid using table loading to prevent using not initialized guids in some code.
-    sObjectMgr.SetHighestGuids();                           // must be after packing instances
-    sLog.outString();
-
-#ifdef ENABLE_ELUNA
-    ///- Initialize Lua Engine
-    sLog.outString("Initialize Eluna Lua Engine...");
-    Eluna::Initialize();
-#endif /* ENABLE_ELUNA */
-
+static void LoadStepPageTexts()
+{
     sLog.outString("Loading Page Texts...");
     sObjectMgr.LoadPageTexts();
+}
 
-    sLog.outString("Loading Game Object Templates...");     // must be after LoadPageTexts
+static void LoadStepGameObjectTemplates()
+{
+    sLog.outString("Loading Game Object Templates...");
     sObjectMgr.LoadGameobjectInfo();
+}
 
+static void LoadStepGameObjectModels()
+{
     sLog.outString("Loading GameObject models...");
     LoadGameObjectModelList();
     sLog.outString();
+}
 
+static void LoadStepSpellChains()
+{
     sLog.outString("Loading Spell Chain Data...");
     sSpellMgr.LoadSpellChains();
+}
 
+static void LoadStepSpellElixirs()
+{
     sLog.outString("Loading Spell Elixir types...");
     sSpellMgr.LoadSpellElixirs();
+}
 
+static void LoadStepSpellLearnSkills()
+{
     sLog.outString("Loading Spell Learn Skills...");
-    sSpellMgr.LoadSpellLearnSkills();                       // must be after LoadSpellChains
+    sSpellMgr.LoadSpellLearnSkills();
+}
 
+static void LoadStepSpellLearnSpells()
+{
     sLog.outString("Loading Spell Learn Spells...");
     sSpellMgr.LoadSpellLearnSpells();
+}
 
+static void LoadStepSpellProcEvents()
+{
     sLog.outString("Loading Spell Proc Event conditions...");
     sSpellMgr.LoadSpellProcEvents();
+}
 
+static void LoadStepSpellBonuses()
+{
     sLog.outString("Loading Spell Bonus Data...");
-    sSpellMgr.LoadSpellBonuses();                           // must be after LoadSpellChains
+    sSpellMgr.LoadSpellBonuses();
+}
 
+static void LoadStepSpellProcItemEnchant()
+{
     sLog.outString("Loading Spell Proc Item Enchant...");
-    sSpellMgr.LoadSpellProcItemEnchant();                   // must be after LoadSpellChains
+    sSpellMgr.LoadSpellProcItemEnchant();
+}
 
+static void LoadStepSpellThreats()
+{
     sLog.outString("Loading Aggro Spells Definitions...");
     sSpellMgr.LoadSpellThreats();
+}
 
+static void LoadStepNpcTexts()
+{
     sLog.outString("Loading NPC Texts...");
     sObjectMgr.LoadGossipText();
+}
 
+static void LoadStepRandomEnchantments()
+{
     sLog.outString("Loading Item Random Enchantments Table...");
     LoadRandomEnchantmentsTable();
+}
 
-    sLog.outString("Loading Disables...");                  // must be before loading quests and items
+static void LoadStepDisables()
+{
+    sLog.outString("Loading Disables...");
     DisableMgr::LoadDisables();
+}
 
-    sLog.outString("Loading Items...");                     // must be after LoadRandomEnchantmentsTable and LoadPageTexts
+static void LoadStepItems()
+{
+    sLog.outString("Loading Items...");
     sObjectMgr.LoadItemPrototypes();
+}
 
-    sLog.outString("Loading Item converts...");             // must be after LoadItemPrototypes
+static void LoadStepItemConverts()
+{
+    sLog.outString("Loading Item converts...");
     sObjectMgr.LoadItemConverts();
+}
 
-    sLog.outString("Loading Item expire converts...");      // must be after LoadItemPrototypes
+static void LoadStepItemExpireConverts()
+{
+    sLog.outString("Loading Item expire converts...");
     sObjectMgr.LoadItemExpireConverts();
+}
 
+static void LoadStepCreatureModelInfo()
+{
     sLog.outString("Loading Creature Model Based Info Data...");
     sObjectMgr.LoadCreatureModelInfo();
+}
 
+static void LoadStepEquipmentTemplates()
+{
     sLog.outString("Loading Equipment templates...");
     sObjectMgr.LoadEquipmentTemplates();
+}
 
+static void LoadStepCreatureClassLvlStats()
+{
     sLog.outString("Loading Creature Stats...");
     sObjectMgr.LoadCreatureClassLvlStats();
+}
 
+static void LoadStepCreatureTemplates()
+{
     sLog.outString("Loading Creature templates...");
     sObjectMgr.LoadCreatureTemplates();
+}
 
+static void LoadStepCreatureTemplateSpells()
+{
     sLog.outString("Loading Creature template spells...");
     sObjectMgr.LoadCreatureTemplateSpells();
+}
 
-    sLog.outString("Loading Creature Model for race...");   // must be after creature templates
+static void LoadStepCreatureModelRace()
+{
+    sLog.outString("Loading Creature Model for race...");
     sObjectMgr.LoadCreatureModelRace();
+}
 
+static void LoadStepSpellScriptTarget()
+{
     sLog.outString("Loading SpellsScriptTarget...");
-    sSpellMgr.LoadSpellScriptTarget();                      // must be after LoadCreatureTemplates and LoadGameobjectInfo
+    sSpellMgr.LoadSpellScriptTarget();
+}
 
-    sLog.outString("Loading Vehicle Accessory...");         // must be after creature templates
+static void LoadStepVehicleAccessory()
+{
+    sLog.outString("Loading Vehicle Accessory...");
     sObjectMgr.LoadVehicleAccessory();
+}
 
+static void LoadStepItemRequiredTarget()
+{
     sLog.outString("Loading ItemRequiredTarget...");
     sObjectMgr.LoadItemRequiredTarget();
+}
 
+static void LoadStepReputationRewardRate()
+{
     sLog.outString("Loading Reputation Reward Rates...");
     sObjectMgr.LoadReputationRewardRate();
+}
 
+static void LoadStepReputationOnKill()
+{
     sLog.outString("Loading Creature Reputation OnKill Data...");
     sObjectMgr.LoadReputationOnKill();
+}
 
+static void LoadStepReputationSpillover()
+{
     sLog.outString("Loading Reputation Spillover Data...");
     sObjectMgr.LoadReputationSpilloverTemplate();
+}
 
+static void LoadStepPointsOfInterest()
+{
     sLog.outString("Loading Points Of Interest Data...");
     sObjectMgr.LoadPointsOfInterest();
+}
+
+/// Initialize the World
+void World::SetInitialWorldSettings()
+{
+    ///- Initialize the random number generator
+    srand((unsigned int)time(NULL));
+
+    ///- Time server startup
+    uint32 startupBegin = GameTime::GetGameTimeMS();
+
+    ///- Initialize detour memory management
+    dtAllocSetCustom(dtCustomAlloc, dtCustomFree);
+
+    ///- Initialize config settings
+    LoadConfigSettings();
+
+    ///- Initialize VMapManager function pointers (to untangle game/collision circular deps)
+    if (VMAP::VMapManager2* vmmgr2 = dynamic_cast<VMAP::VMapManager2*>(VMAP::VMapFactory::createOrGetVMapManager()))
+    {
+        //vmmgr2->GetLiquidFlagsPtr = &GetLiquidFlags;
+        vmmgr2->IsVMAPDisabledForPtr = &DisableMgr::IsVMAPDisabledFor;
+    }
+
+    ///- Check the existence of the map files for all races start areas.
+    if (!MapManager::ExistMapAndVMap(0, -6240.32f, 331.033f) ||                     // Dwarf/ Gnome
+        !MapManager::ExistMapAndVMap(0, -8949.95f, -132.493f) ||                // Human
+        !MapManager::ExistMapAndVMap(1, -618.518f, -4251.67f) ||                // Orc
+        !MapManager::ExistMapAndVMap(0, 1676.35f, 1677.45f) ||                  // Scourge
+        !MapManager::ExistMapAndVMap(1, 10311.3f, 832.463f) ||                  // NightElf
+        !MapManager::ExistMapAndVMap(1, -2917.58f, -257.98f) ||                 // Tauren
+        (m_configUint32Values[CONFIG_UINT32_EXPANSION] >= EXPANSION_TBC &&
+          (!MapManager::ExistMapAndVMap(530, 10349.6f, -6357.29f) ||            // BloodElf
+              !MapManager::ExistMapAndVMap(530, -3961.64f, -13931.2f))) ||          // Draenei
+            (m_configUint32Values[CONFIG_UINT32_EXPANSION] >= EXPANSION_WOTLK &&
+              !MapManager::ExistMapAndVMap(609, 2355.84f, -5664.77f)))              // Death Knight
+    {
+        sLog.outError("Correct *.map files not found in path '%smaps' or *.vmtree/*.vmtile files in '%svmaps'. Please place *.map and vmap files in appropriate directories or correct the DataDir value in the mangosd.conf file.", m_dataPath.c_str(), m_dataPath.c_str());
+        Log::WaitBeforeContinueIfNeed();
+        exit(1);
+    }
+
+    ///- Loading strings. Getting no records means core load has to be canceled because no error message can be output.
+    sLog.outString();
+    sLog.outString("Loading MaNGOS strings...");
+    if (!sObjectMgr.LoadMangosStrings())
+    {
+        Log::WaitBeforeContinueIfNeed();
+        exit(1);                                            // Error message displayed in function already
+    }
+
+    ///- Update the realm entry in the database with the realm type from the config file
+    // No SQL injection as values are treated as integers
+
+    // not send custom type REALM_FFA_PVP to realm list
+    uint32 server_type = IsFFAPvPRealm() ? uint32(REALM_TYPE_PVP) : getConfig(CONFIG_UINT32_GAME_TYPE);
+    uint32 realm_zone = getConfig(CONFIG_UINT32_REALM_ZONE);
+    LoginDatabase.PExecute("UPDATE `realmlist` SET `icon` = %u, `timezone` = %u WHERE `id` = '%u'", server_type, realm_zone, realmID);
+
+    ///- Remove the bones (they should not exist in DB though) and old corpses after a restart
+    CharacterDatabase.PExecute("DELETE FROM `corpse` WHERE `corpse_type` = '0' OR `time` < (UNIX_TIMESTAMP()-'%u')", 3 * DAY);
+
+    ///- Load the DBC files and the data depending only on them
+    StartupLoader dbcStage("DBC stores and spell templates");
+    dbcStage.AddStep("DBCStores", &LoadStepDBCStores);
+    dbcStage.AddStep("DB2Stores", &LoadStepDB2Stores, "DBCStores");
+    dbcStage.AddStep("SpellTemplate", &LoadStepSpellTemplate, "DBCStores");
+    dbcStage.AddStep("ScriptNames", &LoadStepScriptNames);
+    dbcStage.AddStep("InstanceTemplate", &LoadStepInstanceTemplate, "DBCStores ScriptNames");
+    dbcStage.AddStep("SkillLineAbilityMap", &LoadStepSkillLineAbilityMap, "DBCStores");
+    dbcStage.AddStep("SkillRaceClassInfoMap", &LoadStepSkillRaceClassInfoMap, "DBCStores");
+    dbcStage.Run(getConfig(CONFIG_UINT32_STARTUP_THREADS));
+
+    DetectDBCLang();
+    sObjectMgr.SetDBCLocaleIndex(GetDefaultDbcLocale());    // Get once for all the locale index of DBC language (console/broadcasts)
+
+    ///- Clean up and pack instances
+    sLog.outString("Cleaning up instances...");
+    sMapPersistentStateMgr.CleanupInstances();              // must be called before `creature_respawn`/`gameobject_respawn` tables
+
+    sLog.outString("Packing instances...");
+    sMapPersistentStateMgr.PackInstances();
+
+    sLog.outString("Packing groups...");
+    sObjectMgr.PackGroupIds();                              // must be after CleanupInstances
+
+    ///- Init highest guids before any guid using table loading to prevent using not initialized guids in some code.
+    sObjectMgr.SetHighestGuids();                           // must be after packing instances
+    sLog.outString();
+
+#ifdef ENABLE_ELUNA
+    ///- Initialize Lua Engine
+    sLog.outString("Initialize Eluna Lua Engine...");
+    Eluna::Initialize();
+#endif /* ENABLE_ELUNA */
+
+    ///- Templates only read DBC data and each other, the dependencies below replace the old "must be after" ordering
+    StartupLoader templateStage("World templates");
+    templateStage.AddStep("PageTexts", &LoadStepPageTexts);
+    templateStage.AddStep("GameObjectTemplates", &LoadStepGameObjectTemplates, "PageTexts");
+    templateStage.AddStep("GameObjectModels", &LoadStepGameObjectModels);
+    templateStage.AddStep("SpellChains", &LoadStepSpellChains);
+    templateStage.AddStep("SpellElixirs", &LoadStepSpellElixirs);
+    templateStage.AddStep("SpellLearnSkills", &LoadStepSpellLearnSkills, "SpellChains");
+    templateStage.AddStep("SpellLearnSpells", &LoadStepSpellLearnSpells, "SpellChains");
+    templateStage.AddStep("SpellProcEvents", &LoadStepSpellProcEvents, "SpellChains");
+    templateStage.AddStep("SpellBonuses", &LoadStepSpellBonuses, "SpellChains");
+    templateStage.AddStep("SpellProcItemEnchant", &LoadStepSpellProcItemEnchant, "SpellChains");
+    templateStage.AddStep("SpellThreats", &LoadStepSpellThreats, "SpellChains");
+    templateStage.AddStep("NpcTexts", &LoadStepNpcTexts);
+    templateStage.AddStep("RandomEnchantments", &LoadStepRandomEnchantments);
+    templateStage.AddStep("Disables", &LoadStepDisables);
+    templateStage.AddStep("Items", &LoadStepItems, "RandomEnchantments PageTexts Disables");
+    templateStage.AddStep("ItemConverts", &LoadStepItemConverts, "Items");
+    templateStage.AddStep("ItemExpireConverts", &LoadStepItemExpireConverts, "Items");
+    templateStage.AddStep("CreatureModelInfo", &LoadStepCreatureModelInfo);
+    templateStage.AddStep("EquipmentTemplates", &LoadStepEquipmentTemplates);
+    templateStage.AddStep("CreatureClassLvlStats", &LoadStepCreatureClassLvlStats);
+    templateStage.AddStep("CreatureTemplates", &LoadStepCreatureTemplates, "CreatureModelInfo EquipmentTemplates CreatureClassLvlStats");
+    templateStage.AddStep("CreatureTemplateSpells", &LoadStepCreatureTemplateSpells, "CreatureTemplates");
+    templateStage.AddStep("CreatureModelRace", &LoadStepCreatureModelRace, "CreatureTemplates");
+    templateStage.AddStep("SpellScriptTarget", &LoadStepSpellScriptTarget, "CreatureTemplates GameObjectTemplates SpellChains");
+    templateStage.AddStep("VehicleAccessory", &LoadStepVehicleAccessory, "CreatureTemplates");
+    templateStage.AddStep("ItemRequiredTarget", &LoadStepItemRequiredTarget, "Items CreatureTemplates");
+    templateStage.AddStep("ReputationRewardRate", &LoadStepReputationRewardRate);
+    templateStage.AddStep("ReputationOnKill", &LoadStepReputationOnKill, "CreatureTemplates");
+    templateStage.AddStep("ReputationSpillover", &LoadStepReputationSpillover);
+    templateStage.AddStep("PointsOfInterest", &LoadStepPointsOfInterest);
+    templateStage.Run(getConfig(CONFIG_UINT32_STARTUP_THREADS));
+
 
     sLog.outString("Loading Creature Data...");
     sObjectMgr.LoadCreatures();
@@ -1876,6 +2052,18 @@ void World::Update(uint32 diff)
 
         m_timers[WUPDATE_UPTIME].Reset();
         LoginDatabase.PExecute("UPDATE `uptime` SET `uptime` = %u, `maxplayers` = %u WHERE `realmid` = %u AND `starttime` = " UI64FMTD, tmpDiff, maxClientsNum, realmID, uint64(m_startTime));
+
+        PathFindingStats pathFinding = PathCache::GetStats();
+        if (pathFinding.requests)
+        {
+            DETAIL_LOG("Path finding: " UI64FMTD " requests, " UI64FMTD " poly paths from cache, " UI64FMTD " ms spent",
+                       pathFinding.requests, pathFinding.cacheHits, pathFinding.timeUs / 1000);
+        }
+
+        if (uint32 logDropped = sLog.GetAsyncDroppedCount())
+        {
+            DETAIL_LOG("Async log writer: %u records dropped since start", logDropped);
+        }
     }
 
     /// <li> Handle all other objects
@@ -2008,6 +2196,7 @@ void World::SendWorldText(int32 string_id, ...)
 /// Sends a packet to all players with optional team and instance restrictions
 void World::SendGlobalMessage(WorldPacket* packet)
 {
+    SharedWorldPacket shared(*packet);
     for (SessionMap::const_iterator itr = m_sessions.begin(); itr != m_sessions.end(); ++itr)
     {
         if (WorldSession* session = itr->second)
@@ -2015,7 +2204,7 @@ void World::SendGlobalMessage(WorldPacket* packet)
             Player* player = session->GetPlayer();
             if (player && player->IsInWorld())
             {
-                session->SendPacket(packet);
+                session->SendPacket(shared);
             }
         }
     }
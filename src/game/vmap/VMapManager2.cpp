@@ -102,32 +102,47 @@ namespace VMAP
 
     bool VMapManager2::_loadMap(unsigned int pMapId, const std::string& basePath, uint32 tileX, uint32 tileY)
     {
-        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
-        if (instanceTree == iInstanceMapTrees.end())
+        StaticMapTree* tree = findInstanceMapTree(pMapId);
+        if (!tree)
         {
             std::string mapFileName = getMapFileName(pMapId);
-            StaticMapTree* newTree = new StaticMapTree(pMapId, basePath);
-            if (!newTree->InitMap(mapFileName, this))
+            tree = new StaticMapTree(pMapId, basePath);
+            if (!tree->InitMap(mapFileName, this))
             {
                 return false;
             }
-            instanceTree = iInstanceMapTrees.insert(InstanceTreeMap::value_type(pMapId, newTree)).first;
+
+            std::lock_guard<std::mutex> lock(iInstanceMapTreesLock);
+            iInstanceMapTrees.insert(InstanceTreeMap::value_type(pMapId, tree));
         }
-        return instanceTree->second->LoadMapTile(tileX, tileY, this);
+        return tree->LoadMapTile(tileX, tileY, this);
+    }
+
+    //=========================================================
+
+    StaticMapTree* VMapManager2::findInstanceMapTree(uint32 pMapId) const
+    {
+        std::lock_guard<std::mutex> lock(iInstanceMapTreesLock);
+
+        InstanceTreeMap::const_iterator instanceTree = iInstanceMapTrees.find(pMapId);
+        return instanceTree != iInstanceMapTrees.end() ? instanceTree->second : NULL;
     }
 
     //=========================================================
 
     void VMapManager2::unloadMap(unsigned int pMapId)
     {
-        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
-        if (instanceTree != iInstanceMapTrees.end())
+        StaticMapTree* tree = findInstanceMapTree(pMapId);
+        if (tree)
         {
-            instanceTree->second->UnloadMap(this);
-            if (instanceTree->second->numLoadedTiles() == 0)
+            tree->UnloadMap(this);
+            if (tree->numLoadedTiles() == 0)
             {
-                delete instanceTree->second;
-                iInstanceMapTrees.erase(pMapId);
+                {
+                    std::lock_guard<std::mutex> lock(iInstanceMapTreesLock);
+                    iInstanceMapTrees.erase(pMapId);
+                }
+                delete tree;
             }
         }
     }
@@ -136,14 +151,17 @@ namespace VMAP
 
     void VMapManager2::unloadMap(unsigned int  pMapId, int x, int y)
     {
-        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
-        if (instanceTree != iInstanceMapTrees.end())
+        StaticMapTree* tree = findInstanceMapTree(pMapId);
+        if (tree)
         {
-            instanceTree->second->UnloadMapTile(x, y, this);
-            if (instanceTree->second->numLoadedTiles() == 0)
+            tree->UnloadMapTile(x, y, this);
+            if (tree->numLoadedTiles() == 0)
             {
-                delete instanceTree->second;
-                iInstanceMapTrees.erase(pMapId);
+                {
+                    std::lock_guard<std::mutex> lock(iInstanceMapTreesLock);
+                    iInstanceMapTrees.erase(pMapId);
+                }
+                delete tree;
             }
         }
     }
@@ -158,14 +176,13 @@ namespace VMAP
         }
 
         bool result = true;
-        InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
-        if (instanceTree != iInstanceMapTrees.end())
+        if (StaticMapTree* tree = findInstanceMapTree(pMapId))
         {
             Vector3 pos1 = convertPositionToInternalRep(x1, y1, z1);
             Vector3 pos2 = convertPositionToInternalRep(x2, y2, z2);
             if (pos1 != pos2)
             {
-                result = instanceTree->second->isInLineOfSight(pos1, pos2);
+                result = tree->isInLineOfSight(pos1, pos2);
             }
         }
         return result;
@@ -183,13 +200,12 @@ namespace VMAP
         rz = z2;
         if (isLineOfSightCalcEnabled() && !IsVMAPDisabledForPtr(pMapId, VMAP_DISABLE_LOS))
         {
-            InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
-            if (instanceTree != iInstanceMapTrees.end())
+            if (StaticMapTree* tree = findInstanceMapTree(pMapId))
             {
                 Vector3 pos1 = convertPositionToInternalRep(x1, y1, z1);
                 Vector3 pos2 = convertPositionToInternalRep(x2, y2, z2);
                 Vector3 resultPos;
-                result = instanceTree->second->getObjectHitPos(pos1, pos2, resultPos, pModifyDist);
+                result = tree->getObjectHitPos(pos1, pos2, resultPos, pModifyDist);
                 resultPos = convertPositionToInternalRep(resultPos.x, resultPos.y, resultPos.z);
                 rx = resultPos.x;
                 ry = resultPos.y;
@@ -209,11 +225,10 @@ namespace VMAP
         float height = VMAP_INVALID_HEIGHT_VALUE;           // no height
         if (isHeightCalcEnabled() && !IsVMAPDisabledForPtr(pMapId, VMAP_DISABLE_HEIGHT))
         {
-            InstanceTreeMap::iterator instanceTree = iInstanceMapTrees.find(pMapId);
-            if (instanceTree != iInstanceMapTrees.end())
+            if (StaticMapTree* tree = findInstanceMapTree(pMapId))
             {
                 Vector3 pos = convertPositionToInternalRep(x, y, z);
-                height = instanceTree->second->getHeight(pos, maxSearchDist);
+                height = tree->getHeight(pos, maxSearchDist);
                 if (!(height < G3D::inf()))
                 {
                     height = VMAP_INVALID_HEIGHT_VALUE;     // no height
@@ -230,11 +245,10 @@ namespace VMAP
         bool result = false;
         if (!IsVMAPDisabledForPtr(pMapId, VMAP_DISABLE_AREAFLAG))
         {
-            InstanceTreeMap::const_iterator instanceTree = iInstanceMapTrees.find(pMapId);
-            if (instanceTree != iInstanceMapTrees.end())
+            if (StaticMapTree* tree = findInstanceMapTree(pMapId))
             {
                 Vector3 pos = convertPositionToInternalRep(x, y, z);
-                result = instanceTree->second->getAreaInfo(pos, flags, adtId, rootId, groupId);
+                result = tree->getAreaInfo(pos, flags, adtId, rootId, groupId);
                 // z is not touched by convertPositionToMangosRep(), so just copy
                 z = pos.z;
             }
@@ -246,12 +260,11 @@ namespace VMAP
     {
         if (!IsVMAPDisabledForPtr(pMapId, VMAP_DISABLE_LIQUIDSTATUS))
         {
-            InstanceTreeMap::const_iterator instanceTree = iInstanceMapTrees.find(pMapId);
-            if (instanceTree != iInstanceMapTrees.end())
+            if (StaticMapTree* tree = findInstanceMapTree(pMapId))
             {
                 LocationInfo info;
                 Vector3 pos = convertPositionToInternalRep(x, y, z);
-                if (instanceTree->second->GetLocationInfo(pos, info))
+                if (tree->GetLocationInfo(pos, info))
                 {
                     floor = info.ground_Z;
                     type = info.hitModel->GetLiquidType();
@@ -273,6 +286,9 @@ namespace VMAP
 
     WorldModel* VMapManager2::acquireModelInstance(const std::string& basepath, const std::string& filename)
     {
+        // models are shared between map ids and game object models
+        std::lock_guard<std::mutex> lock(iLoadedModelFilesLock);
+
         ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
         if (model == iLoadedModelFiles.end())
         {
@@ -293,6 +309,8 @@ namespace VMAP
 
     void VMapManager2::releaseModelInstance(const std::string& filename)
     {
+        std::lock_guard<std::mutex> lock(iLoadedModelFilesLock);
+
         ModelFileMap::iterator model = iLoadedModelFiles.find(filename);
         if (model == iLoadedModelFiles.end())
         {
@@ -29,6 +29,7 @@
 #include "Utilities/UnorderedMapSet.h"
 #include "Platform/Define.h"
 #include <G3D/Vector3.h>
+#include <mutex>
 
 //===========================================================
 
@@ -121,6 +122,19 @@ namespace VMAP
             ModelFileMap iLoadedModelFiles; /**< TODO */
             InstanceTreeMap iInstanceMapTrees; /**< TODO */
 
+            // the tree of a map id is only used by the thread updating the maps of that id,
+            // the locks only protect the containers that are shared between all map ids
+            mutable std::mutex iInstanceMapTreesLock; /**< guards iInstanceMapTrees */
+            std::mutex iLoadedModelFilesLock; /**< guards iLoadedModelFiles and the model reference counts */
+
+            /**
+             * @brief
+             *
+             * @param pMapId
+             * @return StaticMapTree NULL if the map has no loaded tree
+             */
+            StaticMapTree* findInstanceMapTree(uint32 pMapId) const;
+
             /**
              * @brief
              *
@@ -571,6 +571,9 @@ int main(int argc, char** argv)
 #endif
 
     sLog.outString("Bye!");
+
+    ///- Make sure the async log writer got everything to the files before the process ends
+    sLog.Flush();
     return code;
 }
 /// @}
@@ -33,6 +33,7 @@
 #include "Realm/RealmList.h"
 #include "AuthSocket.h"
 #include "AuthCodes.h"
+#include "AuthWorkerPool.h"
 #include "Patch/PatchHandler.h"
 
 #include <openssl/md5.h>
@@ -142,7 +143,8 @@ typedef struct AuthHandler
 
 
 /// Constructor - set the N and g values for SRP6
-AuthSocket::AuthSocket() : _status(STATUS_CHALLENGE), _accountSecurityLevel(SEC_PLAYER), _build(0), patch_(ACE_INVALID_HANDLE)
+AuthSocket::AuthSocket() : _status(STATUS_CHALLENGE), _accountSecurityLevel(SEC_PLAYER), _build(0), patch_(ACE_INVALID_HANDLE),
+    _pendingWork(NULL), _workPending(false), _closeDeferred(false), _closeAfterWork(false)
 {
     N.SetHexStr("894B645E89E1535BBDAD5B8B290650530801B18EBFBF5E8FAB3C82872A3E9BB7");
     g.SetDword(7);
@@ -183,6 +185,12 @@ void AuthSocket::OnRead()
 
     while (1)
     {
+        ///- Commands are handled in order, so wait for the queued work of the previous one
+        if (_workPending || _closeAfterWork)
+        {
+            return;
+        }
+
         if (!recv_soft((char*)&_cmd, 1))
         {
             return;
@@ -221,6 +229,82 @@ void AuthSocket::OnRead()
     }
 }
 
+/// Destroy the socket, unless a worker still uses it
+void AuthSocket::destroy()
+{
+    if (_workPending)
+    {
+        _closeDeferred = true;
+        return;
+    }
+
+    BufferedSocket::destroy();
+}
+
+/// Run the rest of the current command on the calling thread
+void AuthSocket::ProcessPendingWork()
+{
+    (this->*_pendingWork)();
+}
+
+/// Back on the reactor thread once the worker is done
+void AuthSocket::ResumeAfterWork()
+{
+    _workPending = false;
+
+    if (_closeDeferred)
+    {
+        BufferedSocket::destroy();
+        return;
+    }
+
+    if (_closeAfterWork)
+    {
+        close_connection();
+        return;
+    }
+
+    _SendWorkReply();
+
+    ///- Handle the commands received while the work was pending
+    if (recv_len())
+    {
+        OnRead();
+    }
+}
+
+void AuthSocket::_QueueWork(WorkHandler handler)
+{
+    _pendingWork = handler;
+    _workPending = true;
+
+    if (AuthWorkerPool::instance()->Enqueue(this))
+    {
+        return;
+    }
+
+    ///- No worker available, do the work right away
+    ProcessPendingWork();
+    _workPending = false;
+
+    if (_closeAfterWork)
+    {
+        close_connection();
+        return;
+    }
+
+    _SendWorkReply();
+}
+
+void AuthSocket::_SendWorkReply()
+{
+    if (!_workReply.empty())
+    {
+        send((char const*)_workReply.contents(), _workReply.size());
+        _workReply.clear();
+    }
+}
+
 /// Make the SRP6 calculation from hash in dB
 void AuthSocket::_SetVSFields(const std::string& rI)
 {
@@ -269,7 +353,7 @@ void AuthSocket::SendProof(Sha1Hash sha)
             proof.error = 0;
             proof.unk2 = 0x00;
 
-            send((char*)&proof, sizeof(proof));
+            _workReply.append((uint8 const*)&proof, sizeof(proof));
             break;
         }
         case 8606:                                          // 2.4.3
@@ -291,7 +375,7 @@ void AuthSocket::SendProof(Sha1Hash sha)
             proof.surveyId = 0x00000000;
             proof.unkFlags = 0x0000;
 
-            send((char*)&proof, sizeof(proof));
+            _workReply.append((uint8 const*)&proof, sizeof(proof));
             break;
         }
     }
@@ -347,8 +431,6 @@ bool AuthSocket::_HandleLogonChallenge()
     EndianConvert(ch->timezone_bias);
     EndianConvert(ch->ip);
 
-    ByteBuffer pkt;
-
     _login = (const char*)ch->I;
     _build = ch->build;
     _os = (const char*)ch->os;
@@ -369,6 +451,33 @@ bool AuthSocket::_HandleLogonChallenge()
     _safelogin = _login;
     LoginDatabase.escape_string(_safelogin);
 
+    _localizationName.resize(4);
+    for (int i = 0; i < 4; ++i)
+    {
+        _localizationName[i] = ch->country[4 - i - 1];
+    }
+
+    ///- Refuse the logon while the workers are saturated, the client will retry
+    if (AuthWorkerPool::instance()->IsFull())
+    {
+        ByteBuffer pkt;
+        pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
+        pkt << (uint8) 0x00;
+        pkt << (uint8) WOW_FAIL_DB_BUSY;
+        BASIC_LOG("[AuthChallenge] Too many pending logons, account %s has to retry", _login.c_str());
+        send((char const*)pkt.contents(), pkt.size());
+        return true;
+    }
+
+    _QueueWork(&AuthSocket::_ProcessLogonChallenge);
+    return true;
+}
+
+/// Account checks of the logon challenge, run by an authentication worker
+void AuthSocket::_ProcessLogonChallenge()
+{
+    ByteBuffer pkt;
+
     pkt << (uint8) CMD_AUTH_LOGON_CHALLENGE;
     pkt << (uint8) 0x00;
 
@@ -507,13 +616,7 @@ bool AuthSocket::_HandleLogonChallenge()
                     uint8 secLevel = (*result)[4].GetUInt8();
                     _accountSecurityLevel = secLevel <= SEC_ADMINISTRATOR ? AccountTypes(secLevel) : SEC_ADMINISTRATOR;
 
-                    _localizationName.resize(4);
-                    for (int i = 0; i < 4; ++i)
-                    {
-                        _localizationName[i] = ch->country[4 - i - 1];
-                    }
-
-                    BASIC_LOG("[AuthChallenge] account %s is using '%c%c%c%c' locale (%u)", _login.c_str(), ch->country[3], ch->country[2], ch->country[1], ch->country[0], GetLocaleByName(_localizationName));
+                    BASIC_LOG("[AuthChallenge] account %s is using '%s' locale (%u)", _login.c_str(), _localizationName.c_str(), GetLocaleByName(_localizationName));
 
                     _status = STATUS_LOGON_PROOF;
                 }
@@ -525,8 +628,7 @@ bool AuthSocket::_HandleLogonChallenge()
             pkt << (uint8) WOW_FAIL_UNKNOWN_ACCOUNT;
         }
     }
-    send((char const*)pkt.contents(), pkt.size());
-    return true;
+    _workReply.append(pkt);
 }
 
 /// Logon Proof command handler
@@ -610,15 +712,26 @@ bool AuthSocket::_HandleLogonProof()
     }
     /// </ul>
 
+    memcpy(_proofA, lp.A, sizeof(_proofA));
+    memcpy(_proofM1, lp.M1, sizeof(_proofM1));
+
+    _QueueWork(&AuthSocket::_ProcessLogonProof);
+    return true;
+}
+
+/// SRP6 verification of the logon proof, run by an authentication worker
+void AuthSocket::_ProcessLogonProof()
+{
     ///- Continue the SRP6 calculation based on data received from the client
     BigNumber A;
 
-    A.SetBinary(lp.A, 32);
+    A.SetBinary(_proofA, 32);
 
     // SRP safeguard: abort if A==0
     if ((A % N).isZero())
     {
-        return false;
+        _closeAfterWork = true;
+        return;
     }
 
     Sha1Hash sha;
@@ -687,7 +800,7 @@ bool AuthSocket::_HandleLogonProof()
     M.SetBinary(sha.GetDigest(), 20);
 
     ///- Check if SRP6 results match (password is correct), else send an error
-    if (!memcmp(M.AsByteArray(), lp.M1, 20))
+    if (!memcmp(M.AsByteArray(), _proofM1, 20))
     {
         BASIC_LOG("User '%s' successfully authenticated", _login.c_str());
 
@@ -712,13 +825,13 @@ bool AuthSocket::_HandleLogonProof()
         if (_build > 6005)                                  // > 1.12.2
         {
             char data[4] = { CMD_AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT, 3, 0};
-            send(data, sizeof(data));
+            _workReply.append(data, sizeof(data));
         }
         else
         {
             // 1.x not react incorrectly at 4-byte message use 3 as real error
             char data[2] = { CMD_AUTH_LOGON_PROOF, WOW_FAIL_UNKNOWN_ACCOUNT};
-            send(data, sizeof(data));
+            _workReply.append(data, sizeof(data));
         }
         BASIC_LOG("[AuthChallenge] account %s tried to login with wrong password!", _login.c_str());
 
@@ -760,7 +873,6 @@ bool AuthSocket::_HandleLogonProof()
             }
         }
     }
-    return true;
 }
 
 /// Reconnect Challenge command handler
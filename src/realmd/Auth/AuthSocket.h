@@ -70,6 +70,23 @@ class AuthSocket: public BufferedSocket
          *
          */
         void OnRead() override;
+        /**
+         * @brief Keep the socket alive while its queued work is running, it is destroyed once resumed
+         *
+         */
+        void destroy() override;
+
+        /**
+         * @brief Run the queued database and SRP6 work, called from an authentication worker
+         *
+         */
+        void ProcessPendingWork();
+        /**
+         * @brief Send the result of the queued work and handle the commands received meanwhile
+         *
+         */
+        void ResumeAfterWork();
+
         /**
          * @brief
          *
@@ -171,6 +188,43 @@ class AuthSocket: public BufferedSocket
 
         ACE_HANDLE patch_; /**< TODO */
 
+        /**
+         * @brief
+         *
+         */
+        typedef void (AuthSocket::*WorkHandler)();
+
+        WorkHandler _pendingWork; /**< part of the current command run outside the reactor thread */
+        bool _workPending; /**< no command is handled until the pending work is resumed */
+        bool _closeDeferred; /**< connection was closed while the work was pending */
+        bool _closeAfterWork; /**< the pending work rejected the client, close once back on the reactor thread */
+        ByteBuffer _workReply; /**< reply built by the pending work */
+
+        uint8 _proofA[32]; /**< client public ephemeral value of the logon proof */
+        uint8 _proofM1[20]; /**< client evidence message of the logon proof */
+
+        /**
+         * @brief Hand the rest of the current command to the authentication workers
+         *
+         * @param handler
+         */
+        void _QueueWork(WorkHandler handler);
+        /**
+         * @brief
+         *
+         */
+        void _SendWorkReply();
+        /**
+         * @brief Account checks and first SRP6 step of the logon challenge
+         *
+         */
+        void _ProcessLogonChallenge();
+        /**
+         * @brief SRP6 verification of the logon proof
+         *
+         */
+        void _ProcessLogonProof();
+
         /**
          * @brief
          *
@@ -0,0 +1,189 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2021 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/** \file
+    \ingroup realmd
+*/
+
+#include "AuthWorkerPool.h"
+#include "AuthSocket.h"
+#include "Database/DatabaseEnv.h"
+#include "Log.h"
+
+#include <ace/Singleton.h>
+#include <ace/Guard_T.h>
+#include <ace/Method_Request.h>
+#include <ace/Reactor.h>
+
+extern DatabaseType LoginDatabase;
+
+class AuthWorkRequest : public ACE_Method_Request
+{
+    private:
+        AuthWorkerPool& m_pool;
+        AuthSocket* m_socket;
+
+    public:
+        AuthWorkRequest(AuthWorkerPool& pool, AuthSocket* socket)
+            : m_pool(pool), m_socket(socket)
+        {
+        }
+
+        virtual int call()
+        {
+            m_socket->ProcessPendingWork();
+            m_pool.Finished(m_socket);
+            return 0;
+        }
+};
+
+/// Workers query the login database directly, so every one of them needs its own client library thread state
+class AuthWorkerThreadStart : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            LoginDatabase.ThreadStart();
+            return 0;
+        }
+};
+
+class AuthWorkerThreadEnd : public ACE_Method_Request
+{
+    public:
+        virtual int call()
+        {
+            LoginDatabase.ThreadEnd();
+            return 0;
+        }
+};
+
+AuthWorkerPool::AuthWorkerPool() : m_threads(0), m_maxQueued(0), m_queued(0), m_notified(false)
+{
+}
+
+AuthWorkerPool::~AuthWorkerPool()
+{
+}
+
+AuthWorkerPool* AuthWorkerPool::instance()
+{
+    return ACE_Singleton<AuthWorkerPool, ACE_Thread_Mutex>::instance();
+}
+
+void AuthWorkerPool::Start(uint32 threads, uint32 maxQueued)
+{
+    if (m_threads || !threads)
+    {
+        return;
+    }
+
+    if (m_executor.activate(threads, new AuthWorkerThreadStart, new AuthWorkerThreadEnd) == -1)
+    {
+        sLog.outError("Can't start the authentication worker threads, logons are handled by the network thread");
+        return;
+    }
+
+    m_threads = threads;
+    m_maxQueued = maxQueued;
+
+    sLog.outString("Using %u authentication worker threads", m_threads);
+}
+
+void AuthWorkerPool::Stop()
+{
+    if (!m_threads)
+    {
+        return;
+    }
+
+    m_executor.deactivate();
+    m_threads = 0;
+
+    ACE_Reactor::instance()->purge_pending_notifications(this);
+
+    // requests already taken by a worker are finished by now, resume their sockets
+    ResumeFinished();
+}
+
+bool AuthWorkerPool::IsFull() const
+{
+    return m_maxQueued && m_queued.value() >= m_maxQueued;
+}
+
+bool AuthWorkerPool::Enqueue(AuthSocket* socket)
+{
+    if (!m_threads)
+    {
+        return false;
+    }
+
+    ++m_queued;
+    if (m_executor.execute(new AuthWorkRequest(*this, socket)) == -1)
+    {
+        --m_queued;
+        return false;
+    }
+
+    return true;
+}
+
+void AuthWorkerPool::Finished(AuthSocket* socket)
+{
+    bool notify;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_finishedLock);
+        m_finished.push_back(socket);
+        notify = !m_notified;
+        m_notified = true;
+    }
+
+    // one notification is enough for all sockets finished before the reactor gets to them
+    if (notify)
+    {
+        ACE_Reactor::instance()->notify(this, ACE_Event_Handler::EXCEPT_MASK);
+    }
+}
+
+int AuthWorkerPool::handle_exception(ACE_HANDLE)
+{
+    ResumeFinished();
+    return 0;
+}
+
+void AuthWorkerPool::ResumeFinished()
+{
+    SocketList finished;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_finishedLock);
+        finished.swap(m_finished);
+        m_notified = false;
+    }
+
+    for (SocketList::const_iterator itr = finished.begin(); itr != finished.end(); ++itr)
+    {
+        --m_queued;
+        (*itr)->ResumeAfterWork();
+    }
+}
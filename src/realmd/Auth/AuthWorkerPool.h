@@ -0,0 +1,139 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2021 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+/// \addtogroup realmd
+/// @{
+/// \file
+
+#ifndef MANGOS_H_AUTHWORKERPOOL
+#define MANGOS_H_AUTHWORKERPOOL
+
+#include "Common.h"
+#include "Threading/DelayExecutor.h"
+
+#include <ace/Event_Handler.h>
+#include <ace/Thread_Mutex.h>
+#include <ace/Atomic_Op.h>
+#include <vector>
+
+class AuthSocket;
+
+/**
+ * @brief Runs the database lookups and SRP6 math of logon requests outside the reactor thread
+ *
+ * A socket handed to the pool is processed by one of the worker threads, then
+ * queued back and resumed on the reactor thread, which is woken up through a
+ * reactor notification. The pool never touches the socket I/O itself.
+ */
+class AuthWorkerPool : public ACE_Event_Handler
+{
+    public:
+        /**
+         * @brief
+         *
+         */
+        AuthWorkerPool();
+        /**
+         * @brief
+         *
+         */
+        ~AuthWorkerPool();
+
+        /**
+         * @brief
+         *
+         * @return AuthWorkerPool
+         */
+        static AuthWorkerPool* instance();
+
+        /**
+         * @brief Start the worker threads, logon requests are handled on the reactor thread until then
+         *
+         * @param threads number of worker threads, 0 keeps everything on the reactor thread
+         * @param maxQueued number of queued requests above which new logons are refused
+         */
+        void Start(uint32 threads, uint32 maxQueued);
+        /**
+         * @brief Stop the worker threads and resume the sockets whose work is already done
+         *
+         */
+        void Stop();
+
+        /**
+         * @brief
+         *
+         * @return bool true when requests can be handed to the workers
+         */
+        bool IsActive() const { return m_threads > 0; }
+        /**
+         * @brief
+         *
+         * @return bool true when the queue reached its bound and new logons should be refused
+         */
+        bool IsFull() const;
+
+        /**
+         * @brief Queue the pending work of the socket, called from the reactor thread
+         *
+         * @param socket
+         * @return bool false if the request could not be queued
+         */
+        bool Enqueue(AuthSocket* socket);
+
+        /**
+         * @brief Hand a processed socket back to the reactor thread, called from the workers
+         *
+         * @param socket
+         */
+        void Finished(AuthSocket* socket);
+
+        /**
+         * @brief Resume the processed sockets, called by the reactor on notification
+         *
+         * @param
+         * @return int
+         */
+        int handle_exception(ACE_HANDLE) override;
+
+    private:
+        typedef std::vector<AuthSocket*> SocketList;
+
+        DelayExecutor m_executor; /**< TODO */
+        uint32 m_threads; /**< TODO */
+        uint32 m_maxQueued; /**< TODO */
+        ACE_Atomic_Op<ACE_Thread_Mutex, uint32> m_queued; /**< requests handed to the workers and not resumed yet */
+
+        ACE_Thread_Mutex m_finishedLock; /**< TODO */
+        SocketList m_finished; /**< processed sockets waiting for the reactor thread */
+        bool m_notified; /**< a reactor notification is already pending for m_finished */
+
+        /**
+         * @brief
+         *
+         */
+        void ResumeFinished();
+};
+
+#endif
+/// @}
@@ -33,6 +33,7 @@
 #include "Config/Config.h"
 #include "Log.h"
 #include "Auth/AuthSocket.h"
+#include "Auth/AuthWorkerPool.h"
 #include "SystemConfig.h"
 #include "revision.h"
 #include "Util.h"
@@ -344,6 +345,9 @@ extern int main(int argc, char** argv)
     // server has started up successfully => enable async DB requests
     LoginDatabase.AllowAsyncTransactions();
 
+    ///- Move the logon database lookups and SRP6 math off the network thread
+    AuthWorkerPool::instance()->Start(sConfig.GetIntDefault("Auth.WorkerThreads", 2), sConfig.GetIntDefault("Auth.MaxPendingLogons", 500));
+
     // maximum counter for next ping
     uint32 numLoops = (sConfig.GetIntDefault("MaxPingTime", 30) * (MINUTE * 1000000 / 100000));
     uint32 loopCounter = 0;
@@ -377,6 +381,9 @@ extern int main(int argc, char** argv)
 #endif
     }
 
+    ///- Wait for the authentication workers, they may still queue async statements
+    AuthWorkerPool::instance()->Stop();
+
     ///- Wait for the delay thread to exit
     LoginDatabase.HaltDelayThread();
 
@@ -384,6 +391,9 @@ extern int main(int argc, char** argv)
     UnhookSignals();
 
     sLog.outString("Halting process...");
+
+    ///- Make sure the async log writer got everything to the files before the process ends
+    sLog.Flush();
     return 0;
 }
 
@@ -417,9 +427,11 @@ bool StartDB()
         return false;
     }
 
-    sLog.outString("Login Database total connections: %i", 1 + 1);
+    int nConnections = sConfig.GetIntDefault("LoginDatabaseConnections", 1);
+
+    sLog.outString("Login Database total connections: %i", nConnections + 1);
 
-    if (!LoginDatabase.Initialize(dbstring.c_str()))
+    if (!LoginDatabase.Initialize(dbstring.c_str(), nConnections))
     {
         sLog.outError("Can not connect to database");
         return false;
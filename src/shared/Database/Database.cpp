@@ -141,6 +141,7 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
     }
 
     m_pingIntervallms = sConfig.GetIntDefault("MaxPingTime", 30) * (MINUTE * 1000);
+    m_asyncBatchSize = std::max(1, sConfig.GetIntDefault("Database.AsyncBatchSize", 32));
 
     // create DB connections
 
@@ -178,6 +179,13 @@ bool Database::Initialize(const char* infoString, int nConns /*= 1*/)
         return false;
     }
 
+    // a failed batch is rolled back and replayed, which would apply statements on non transactional tables twice
+    if (m_asyncBatchSize > 1 && !m_pAsyncConn->IsFullyTransactional())
+    {
+        sLog.outString("Database uses non transactional tables, async statements will not be batched");
+        m_asyncBatchSize = 1;
+    }
+
     m_pResultQueue = new SqlResultQueue;
 
     InitDelayThread();
@@ -205,7 +213,7 @@ void Database::StopServer()
 SqlDelayThread* Database::CreateDelayThread()
 {
     assert(m_pAsyncConn);
-    return new SqlDelayThread(this, m_pAsyncConn);
+    return new SqlDelayThread(this, m_pAsyncConn, m_asyncBatchSize);
 }
 
 void Database::InitDelayThread()
@@ -122,6 +122,12 @@ class SqlConnection
          * @return bool
          */
         virtual bool RollbackTransaction() { return true; }
+        /**
+         * @brief checks that a rollback undoes changes to every table of the database
+         *
+         * @return bool
+         */
+        virtual bool IsFullyTransactional() { return false; }
 
         /**
          * @brief methods to work with prepared statements
@@ -657,10 +663,10 @@ class Database
          * @brief
          *
          */
-        Database() :
+        Database() : m_TransStorage(NULL),
             m_nQueryConnPoolSize(1), m_pAsyncConn(NULL), m_pResultQueue(NULL),
             m_threadBody(NULL), m_delayThread(NULL), m_bAllowAsyncTransactions(false),
-            m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0), m_TransStorage(NULL)
+            m_iStmtIndex(-1), m_logSQL(false), m_pingIntervallms(0), m_asyncBatchSize(1)
         {
             m_nQueryCounter = -1;
         }
@@ -822,5 +828,6 @@ class Database
         bool m_logSQL; /**< TODO */
         std::string m_logsDir; /**< TODO */
         uint32 m_pingIntervallms; /**< TODO */
+        uint32 m_asyncBatchSize;                            /**< Max async statements coalesced into one transaction */
 };
 #endif
@@ -337,6 +337,21 @@ bool MySQLConnection::RollbackTransaction()
     return _TransactionCmd("ROLLBACK");
 }
 
+bool MySQLConnection::IsFullyTransactional()
+{
+    // tables whose engine does not support transactions, or is not known to the server at all
+    QueryResult* result = Query("SELECT COUNT(*) FROM information_schema.TABLES t LEFT JOIN information_schema.ENGINES e ON e.ENGINE = t.ENGINE "
+                                "WHERE t.TABLE_SCHEMA = DATABASE() AND t.TABLE_TYPE = 'BASE TABLE' AND (e.TRANSACTIONS IS NULL OR e.TRANSACTIONS <> 'YES')");
+    if (!result)
+    {
+        return false;
+    }
+
+    bool transactional = result->Fetch()[0].GetUInt64() == 0;
+    delete result;
+    return transactional;
+}
+
 unsigned long MySQLConnection::escape_string(char* to, const char* from, unsigned long length)
 {
     if (!mMysql || !to || !from || !length)
@@ -189,6 +189,12 @@ class MySQLConnection : public SqlConnection
          * @return bool
          */
         bool RollbackTransaction() override;
+        /**
+         * @brief checks that every table of the database uses an engine with transactions (not MyISAM, MEMORY, ...)
+         *
+         * @return bool
+         */
+        bool IsFullyTransactional() override;
 
     protected:
         /**
@@ -24,6 +24,71 @@
 
 #include "SQLStorage.h"
 
+#include <ace/Mem_Map.h>
+#include <ace/OS_NS_stdio.h>
+#include <ace/OS_NS_unistd.h>
+
+#define SQL_STORAGE_SNAPSHOT_MAGIC      0x5153514D          // "MQSQ"
+#define SQL_STORAGE_SNAPSHOT_VERSION    1
+
+/**
+ * @brief file header of a table snapshot
+ *
+ * Followed by the key string, the record ids, the records with string
+ * pointers replaced by pool offsets (+1, 0 for NULL) and the string pool.
+ */
+struct SQLStorageSnapshotHeader
+{
+    uint32 magic;
+    uint32 version;
+    uint32 pointerSize;
+    uint32 recordSize;
+    uint32 recordCount;
+    uint32 maxEntry;
+    uint32 keySize;
+    uint32 stringPoolSize;
+    uint32 checksum;                                        // FNV-1a of everything after the header
+};
+
+static uint32 SnapshotChecksum(char const* data, size_t size, uint32 hash = 2166136261u)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ uint8(data[i])) * 16777619u;
+    }
+
+    return hash;
+}
+
+/// Offsets of all pointer fields (strings) inside a record of the given destination format
+static void GetPointerFieldOffsets(char const* dstFormat, uint32 fieldCount, std::vector<uint32>& offsets)
+{
+    uint32 offset = 0;
+    for (uint32 x = 0; x < fieldCount; ++x)
+    {
+        switch (dstFormat[x])
+        {
+            case DBC_FF_LOGIC:
+                offset += sizeof(bool);
+                break;
+            case DBC_FF_STRING:
+            case DBC_FF_NA_POINTER:
+                offsets.push_back(offset);
+                offset += sizeof(char*);
+                break;
+            case DBC_FF_BYTE:
+            case DBC_FF_NA_BYTE:
+                offset += sizeof(char);
+                break;
+            default:                                        // int and float fields, formats were already validated by the loader
+                offset += sizeof(uint32);
+                break;
+        }
+    }
+}
+
+std::string SQLStorageBase::m_snapshotDirectory;
+
 // -----------------------------------  SQLStorageBase  ---------------------------------------- //
 
 SQLStorageBase::SQLStorageBase() :
@@ -55,6 +120,12 @@ char* SQLStorageBase::createRecord(uint32 recordId)
     char* newRecord = &m_data[m_recordCount * m_recordSize];
     ++m_recordCount;
 
+    // the derived indexes do not allow walking the records in storage order, keep the ids for SaveSnapshot
+    if (IsSnapshotEnabled())
+    {
+        m_recordIds.push_back(recordId);
+    }
+
     JustCreatedRecord(recordId, newRecord);
     return newRecord;
 }
@@ -125,6 +196,200 @@ void SQLStorageBase::Free()
     delete[] m_data;
     m_data = NULL;
     m_recordCount = 0;
+
+    m_recordIds.clear();
+}
+
+void SQLStorageBase::SetSnapshotDirectory(std::string const& directory)
+{
+    m_snapshotDirectory = directory;
+
+    // normalize dir path to path/ or path\ form
+    if (!m_snapshotDirectory.empty() && m_snapshotDirectory.at(m_snapshotDirectory.length() - 1) != '/' && m_snapshotDirectory.at(m_snapshotDirectory.length() - 1) != '\\')
+    {
+        m_snapshotDirectory.append("/");
+    }
+}
+
+std::string SQLStorageBase::GetSnapshotFileName() const
+{
+    return m_snapshotDirectory + m_tableName + ".snapshot";
+}
+
+bool SQLStorageBase::LoadSnapshot(std::string const& key, uint32 recordSize)
+{
+    std::string fileName = GetSnapshotFileName();
+
+    ACE_Mem_Map mapping;
+    if (mapping.map(fileName.c_str(), -1, O_RDONLY, ACE_DEFAULT_FILE_PERMS, PROT_READ, ACE_MAP_PRIVATE) == -1)
+    {
+        return false;
+    }
+
+    mapping.close_handle();
+
+    char const* data = static_cast<char const*>(mapping.addr());
+    size_t size = mapping.size();
+
+    SQLStorageSnapshotHeader header;
+    if (size < sizeof(header))
+    {
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(header));
+
+    if (header.magic != SQL_STORAGE_SNAPSHOT_MAGIC || header.version != SQL_STORAGE_SNAPSHOT_VERSION ||
+        header.pointerSize != sizeof(char*) || header.recordSize != recordSize || header.keySize != key.size())
+    {
+        return false;
+    }
+
+    size_t expectedSize = sizeof(header) + size_t(header.keySize) + size_t(header.recordCount) * (sizeof(uint32) + header.recordSize) + header.stringPoolSize;
+    if (size != expectedSize || SnapshotChecksum(data + sizeof(header), size - sizeof(header)) != header.checksum)
+    {
+        sLog.outError("Table snapshot %s is damaged, loading `%s` from the database", fileName.c_str(), m_tableName);
+        return false;
+    }
+
+    char const* keyData = data + sizeof(header);
+    if (memcmp(keyData, key.c_str(), key.size()) != 0)
+    {
+        return false;                                       // table or dependencies changed since the snapshot was written
+    }
+
+    char const* ids = keyData + header.keySize;
+    char const* records = ids + header.recordCount * sizeof(uint32);
+    char const* pool = records + header.recordCount * header.recordSize;
+
+    std::vector<uint32> pointerOffsets;
+    GetPointerFieldOffsets(m_dst_format, m_dstFieldCount, pointerOffsets);
+
+    prepareToLoad(header.maxEntry, header.recordCount, header.recordSize);
+
+    for (uint32 i = 0; i < header.recordCount; ++i)
+    {
+        uint32 id;
+        memcpy(&id, ids + i * sizeof(uint32), sizeof(uint32));
+
+        char* record = createRecord(id);
+        memcpy(record, records + i * header.recordSize, header.recordSize);
+
+        for (std::vector<uint32>::const_iterator itr = pointerOffsets.begin(); itr != pointerOffsets.end(); ++itr)
+        {
+            size_t poolOffset;
+            memcpy(&poolOffset, record + *itr, sizeof(poolOffset));
+
+            // every string gets its own allocation like on the database path, users may free or replace it
+            char* str = NULL;
+            if (poolOffset && poolOffset <= header.stringPoolSize)
+            {
+                char const* src = pool + poolOffset - 1;
+                char const* end = static_cast<char const*>(memchr(src, 0, header.stringPoolSize - (poolOffset - 1)));
+                size_t len = end ? size_t(end - src) : size_t(header.stringPoolSize - (poolOffset - 1));
+
+                str = new char[len + 1];
+                memcpy(str, src, len);
+                str[len] = 0;
+            }
+            memcpy(record + *itr, &str, sizeof(str));
+        }
+    }
+
+    m_recordIds.clear();
+    return true;
+}
+
+void SQLStorageBase::SaveSnapshot(std::string const& key)
+{
+    std::vector<uint32> pointerOffsets;
+    GetPointerFieldOffsets(m_dst_format, m_dstFieldCount, pointerOffsets);
+
+    std::vector<uint32> ids;
+    ids.swap(m_recordIds);
+
+    if (key.empty())
+    {
+        return;
+    }
+    std::vector<char> records(m_data, m_data + m_recordCount * m_recordSize);
+    std::string pool;
+    UNORDERED_MAP<std::string, size_t> poolIndex;
+
+    for (uint32 i = 0; i < m_recordCount; ++i)
+    {
+        char* record = &records[i * m_recordSize];
+
+        for (std::vector<uint32>::const_iterator itr = pointerOffsets.begin(); itr != pointerOffsets.end(); ++itr)
+        {
+            char const* str;
+            memcpy(&str, record + *itr, sizeof(str));
+
+            size_t poolOffset = 0;
+            if (str)
+            {
+                std::pair<UNORDERED_MAP<std::string, size_t>::iterator, bool> inserted = poolIndex.insert(std::make_pair(std::string(str), pool.size() + 1));
+                if (inserted.second)
+                {
+                    pool.append(str, strlen(str) + 1);
+                }
+
+                poolOffset = inserted.first->second;
+            }
+
+            memcpy(record + *itr, &poolOffset, sizeof(poolOffset));
+        }
+    }
+
+    SQLStorageSnapshotHeader header;
+    header.magic = SQL_STORAGE_SNAPSHOT_MAGIC;
+    header.version = SQL_STORAGE_SNAPSHOT_VERSION;
+    header.pointerSize = sizeof(char*);
+    header.recordSize = m_recordSize;
+    header.recordCount = m_recordCount;
+    header.maxEntry = m_maxEntry;
+    header.keySize = key.size();
+    header.stringPoolSize = pool.size();
+
+    uint32 checksum = SnapshotChecksum(key.c_str(), key.size());
+    if (!ids.empty())
+    {
+        checksum = SnapshotChecksum(reinterpret_cast<char const*>(&ids[0]), ids.size() * sizeof(uint32), checksum);
+        checksum = SnapshotChecksum(&records[0], records.size(), checksum);
+    }
+    header.checksum = SnapshotChecksum(pool.c_str(), pool.size(), checksum);
+
+    // write to a temporary file first, a crash while writing must not leave a half written snapshot behind
+    std::string fileName = GetSnapshotFileName();
+    std::string tmpName = fileName + ".tmp";
+
+    FILE* file = ACE_OS::fopen(tmpName.c_str(), "wb");
+    if (!file)
+    {
+        sLog.outError("Can't create table snapshot %s", tmpName.c_str());
+        return;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(key.c_str(), 1, key.size(), file) == key.size();
+    if (ok && !ids.empty())
+    {
+        ok = fwrite(&ids[0], sizeof(uint32), ids.size(), file) == ids.size() && fwrite(&records[0], 1, records.size(), file) == records.size();
+    }
+    ok = ok && fwrite(pool.c_str(), 1, pool.size(), file) == pool.size();
+
+    if (ACE_OS::fclose(file) != 0 || !ok)
+    {
+        sLog.outError("Can't write table snapshot %s", tmpName.c_str());
+        ACE_OS::unlink(tmpName.c_str());
+        return;
+    }
+
+    ACE_OS::unlink(fileName.c_str());
+    if (ACE_OS::rename(tmpName.c_str(), fileName.c_str()) != 0)
+    {
+        sLog.outError("Can't replace table snapshot %s", fileName.c_str());
+        ACE_OS::unlink(tmpName.c_str());
+    }
 }
 
 // -----------------------------------  SQLStorage  -------------------------------------------- //
@@ -91,6 +91,19 @@ class SQLStorageBase
          */
         uint32 GetRecordCount() const { return m_recordCount; }
 
+        /**
+         * @brief set the directory binary snapshots of loaded tables are kept in
+         *
+         * @param directory empty string disables snapshots
+         */
+        static void SetSnapshotDirectory(std::string const& directory);
+        /**
+         * @brief
+         *
+         * @return bool true if snapshots are written and used
+         */
+        static bool IsSnapshotEnabled() { return !m_snapshotDirectory.empty(); }
+
         template<typename T>
         /**
          * @brief
@@ -237,6 +250,27 @@ class SQLStorageBase
          */
         char* createRecord(uint32 recordId);
 
+        /**
+         * @brief load the records from the table snapshot instead of the database
+         *
+         * @param key identifies the table format and content the snapshot must have been written for
+         * @param recordSize size of one record for the current format
+         * @return bool false if there is no matching and intact snapshot
+         */
+        bool LoadSnapshot(std::string const& key, uint32 recordSize);
+        /**
+         * @brief write the currently loaded records to the table snapshot
+         *
+         * @param key nothing is written if empty
+         */
+        void SaveSnapshot(std::string const& key);
+        /**
+         * @brief
+         *
+         * @return std::string snapshot file of this table
+         */
+        std::string GetSnapshotFileName() const;
+
         // Information about the table
         const char* m_tableName; /**< TODO */
         const char* m_entry_field; /**< TODO */
@@ -252,6 +286,9 @@ class SQLStorageBase
 
         // Data Storage
         char* m_data; /**< TODO */
+        std::vector<uint32> m_recordIds; /**< ids in storage order, only collected until the snapshot is written */
+
+        static std::string m_snapshotDirectory; /**< empty if snapshots are disabled */
 };
 
 /**
@@ -701,6 +738,16 @@ class SQLStorageLoaderBase
          */
         void default_fill_to_str(uint32 field_pos, char const* src, char*& dst);
 
+        /**
+         * @brief tables the converted values depend on besides the loaded one
+         *
+         * Their checksums are part of the snapshot key, so e.g. loaders
+         * resolving script names return "script_binding".
+         *
+         * @return const char space separated table names
+         */
+        char const* GetSnapshotDependencies() const { return ""; }
+
         template<class D>
         /**
          * @brief trap, no body
@@ -752,6 +799,14 @@ class SQLStorageLoaderBase
          * @param offset
          */
         void storeValue(char* value, StorageClass& store, char* record, uint32 field_pos, uint32& offset);
+
+        /**
+         * @brief
+         *
+         * @param store
+         * @return std::string table, formats and table checksums a snapshot must match
+         */
+        std::string GetSnapshotKey(StorageClass& store);
 };
 
 /**
@@ -28,6 +28,7 @@
 #include "Utilities/ProgressBar.h"
 #include "Log/Log.h"
 #include "DataStores/DBCFileLoader.h"
+#include "Utilities/Util.h"
 
 template<class DerivedLoader, class StorageClass>
 template<class S, class D>
@@ -264,6 +265,52 @@ template<class DerivedLoader, class StorageClass>
 void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store, bool error_at_empty /*= true*/)
 {
     Field* fields = NULL;
+    uint32 recordsize = 0;
+
+    // get struct size
+    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
+    {
+        switch (store.GetDstFormat(x))
+        {
+            case DBC_FF_LOGIC:
+                recordsize += sizeof(bool);   break;
+            case DBC_FF_BYTE:
+                recordsize += sizeof(char);   break;
+            case DBC_FF_INT:
+                recordsize += sizeof(uint32); break;
+            case DBC_FF_FLOAT:
+                recordsize += sizeof(float);  break;
+            case DBC_FF_STRING:
+                recordsize += sizeof(char*);  break;
+            case DBC_FF_NA:
+                recordsize += sizeof(uint32); break;
+            case DBC_FF_NA_BYTE:
+                recordsize += sizeof(char);   break;
+            case DBC_FF_NA_FLOAT:
+                recordsize += sizeof(float);  break;
+            case DBC_FF_NA_POINTER:
+                recordsize += sizeof(char*);  break;
+            case DBC_FF_IND:
+            case DBC_FF_SORT:
+                assert(false && "SQL storage not have sort field types");
+                break;
+            default:
+                assert(false && "unknown format character");
+                break;
+        }
+    }
+
+    std::string snapshotKey;
+    if (SQLStorageBase::IsSnapshotEnabled())
+    {
+        snapshotKey = GetSnapshotKey(store);
+        if (!snapshotKey.empty() && store.LoadSnapshot(snapshotKey, recordsize))
+        {
+            sLog.outString("Loaded %s from snapshot", store.GetTableName());
+            return;
+        }
+    }
+
     QueryResult* result  = WorldDatabase.PQuery("SELECT MAX(`%s`) FROM `%s`", store.EntryFieldName(), store.GetTableName());
     if (!result)
     {
@@ -274,7 +321,6 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
 
     uint32 maxRecordId = (*result)[0].GetUInt32() + 1;
     uint32 recordCount = 0;
-    uint32 recordsize = 0;
     delete result;
 
     result = WorldDatabase.PQuery("SELECT COUNT(*) FROM `%s`", store.GetTableName());
@@ -311,40 +357,6 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         exit(1);                                            // Stop server at loading broken or non-compatible table.
     }
 
-    // get struct size
-    uint32 offset = 0;
-    for (uint32 x = 0; x < store.GetDstFieldCount(); ++x)
-    {
-        switch (store.GetDstFormat(x))
-        {
-            case DBC_FF_LOGIC:
-                recordsize += sizeof(bool);   break;
-            case DBC_FF_BYTE:
-                recordsize += sizeof(char);   break;
-            case DBC_FF_INT:
-                recordsize += sizeof(uint32); break;
-            case DBC_FF_FLOAT:
-                recordsize += sizeof(float);  break;
-            case DBC_FF_STRING:
-                recordsize += sizeof(char*);  break;
-            case DBC_FF_NA:
-                recordsize += sizeof(uint32); break;
-            case DBC_FF_NA_BYTE:
-                recordsize += sizeof(char);   break;
-            case DBC_FF_NA_FLOAT:
-                recordsize += sizeof(float);  break;
-            case DBC_FF_NA_POINTER:
-                recordsize += sizeof(char*);  break;
-            case DBC_FF_IND:
-            case DBC_FF_SORT:
-                assert(false && "SQL storage not have sort field types");
-                break;
-            default:
-                assert(false && "unknown format character");
-                break;
-        }
-    }
-
     // Prepare data storage and lookup storage
     store.prepareToLoad(maxRecordId, recordCount, recordsize);
 
@@ -355,7 +367,7 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
         bar.step();
 
         char* record = store.createRecord(fields[0].GetUInt32());
-        offset = 0;
+        uint32 offset = 0;
 
         // dependend on dest-size
         // iterate two indexes: x over dest, y over source
@@ -406,6 +418,69 @@ void SQLStorageLoaderBase<DerivedLoader, StorageClass>::Load(StorageClass& store
     while (result->NextRow());
 
     delete result;
+
+    // only reached with a key if the snapshot was missing, damaged or written for other table contents,
+    // without a key SaveSnapshot just drops the collected record ids
+    if (SQLStorageBase::IsSnapshotEnabled())
+    {
+        store.SaveSnapshot(snapshotKey);
+    }
+}
+
+template<class DerivedLoader, class StorageClass>
+/**
+ * @brief build the key a snapshot of the store must match to be used
+ *
+ * @param store
+ * @return std::string empty if neither a live checksum nor the last change time is available
+ */
+std::string SQLStorageLoaderBase<DerivedLoader, StorageClass>::GetSnapshotKey(StorageClass& store)
+{
+    std::string key = std::string(store.GetTableName()) + "|" + store.GetSrcFormat() + "|" + store.GetDstFormat();
+
+    std::string tables = store.GetTableName();
+    tables += " ";
+    tables += static_cast<DerivedLoader*>(this)->GetSnapshotDependencies();
+
+    Tokens names = StrSplit(tables, " ");
+    for (Tokens::const_iterator itr = names.begin(); itr != names.end(); ++itr)
+    {
+        if (itr->empty())
+        {
+            continue;
+        }
+
+        // QUICK only reports the live checksum MyISAM keeps with CHECKSUM=1, it never scans the table
+        QueryResult* result = WorldDatabase.PQuery("CHECKSUM TABLE `%s` QUICK", itr->c_str());
+        if (result && !result->Fetch()[1].IsNULL())
+        {
+            key += "|" + *itr + "=" + result->Fetch()[1].GetCppString();
+            delete result;
+            continue;
+        }
+
+        delete result;
+
+        // otherwise rely on the table metadata, without a known last change time the snapshot can not be trusted
+        result = WorldDatabase.PQuery("SELECT `CREATE_TIME`, `UPDATE_TIME` FROM `information_schema`.`TABLES` "
+                                      "WHERE `TABLE_SCHEMA` = DATABASE() AND `TABLE_NAME` = '%s'", itr->c_str());
+        if (!result)
+        {
+            return std::string();
+        }
+
+        Field* fields = result->Fetch();
+        if (fields[0].IsNULL() || fields[1].IsNULL())
+        {
+            delete result;
+            return std::string();
+        }
+
+        key += "|" + *itr + "=" + fields[0].GetCppString() + "/" + fields[1].GetCppString();
+        delete result;
+    }
+
+    return key;
 }
 
 #endif
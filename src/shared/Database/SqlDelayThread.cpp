@@ -25,9 +25,14 @@
 #include "Database/SqlDelayThread.h"
 #include "Database/SqlOperations.h"
 #include "DatabaseEnv.h"
+#include "Timer.h"
 
-SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn) : m_dbEngine(db), m_dbConnection(conn), m_running(true)
+#include <cstring>
+
+SqlDelayThread::SqlDelayThread(Database* db, SqlConnection* conn, uint32 batchSize) : m_queueCond(m_queueLock),
+    m_dbEngine(db), m_dbConnection(conn), m_running(true), m_batchSize(batchSize ? batchSize : 1), m_totalLatencyMs(0)
 {
+    memset(&m_stats, 0, sizeof(m_stats));
 }
 
 SqlDelayThread::~SqlDelayThread()
@@ -36,29 +41,72 @@ SqlDelayThread::~SqlDelayThread()
     ProcessRequests();
 }
 
+bool SqlDelayThread::Delay(SqlOperation* sql)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_queueLock, false);
+
+    QueuedOperation queued;
+    queued.op = sql;
+    queued.queueTime = getMSTime();
+    m_sqlQueue.push_back(queued);
+
+    if (m_sqlQueue.size() > m_stats.maxQueueDepth)
+    {
+        m_stats.maxQueueDepth = m_sqlQueue.size();
+    }
+
+    // only the first request has to wake the thread, it drains the whole queue
+    if (m_sqlQueue.size() == 1)
+    {
+        m_queueCond.signal();
+    }
+    return true;
+}
+
+SqlDelayStats SqlDelayThread::GetStats()
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_queueLock, m_stats);
+
+    SqlDelayStats stats = m_stats;
+    stats.queueDepth = m_sqlQueue.size();
+    stats.avgLatencyMs = m_stats.processed ? uint32(m_totalLatencyMs / m_stats.processed) : 0;
+    return stats;
+}
+
 void SqlDelayThread::run()
 {
 #ifndef DO_POSTGRESQL
     mysql_thread_init();
 #endif
 
-    const uint32 loopSleepms = 10;
-
-    const uint32 pingEveryLoop = m_dbEngine->GetPingIntervall() / loopSleepms;
-
-    uint32 loopCounter = 0;
+    uint32 lastPing = getMSTime();
     while (m_running)
     {
-        // if the running state gets turned off while sleeping
-        // empty the queue before exiting
-        ACE_Based::Thread::Sleep(loopSleepms);
+        // keep a minimum wait so a ping interval of 0 does not turn the loop into a busy spin
+        uint32 pingIn = m_dbEngine->GetPingIntervall() - std::min(getMSTimeDiff(lastPing, getMSTime()), m_dbEngine->GetPingIntervall());
+        pingIn = std::max(pingIn, uint32(10));
+        {
+            // sleep until work is queued instead of polling, wake up anyway when the connection has to be pinged
+            ACE_GUARD(ACE_Thread_Mutex, guard, m_queueLock);
+            if (m_sqlQueue.empty() && m_running)
+            {
+                ACE_Time_Value timeout = ACE_OS::gettimeofday() + ACE_Time_Value(pingIn / IN_MILLISECONDS, (pingIn % IN_MILLISECONDS) * 1000);
+                m_queueCond.wait(&timeout);
+            }
+        }
 
+        // if the running state gets turned off while waiting
+        // empty the queue before exiting
         ProcessRequests();
 
-        if ((loopCounter++) >= pingEveryLoop)
+        if (getMSTimeDiff(lastPing, getMSTime()) >= m_dbEngine->GetPingIntervall())
         {
-            loopCounter = 0;
+            lastPing = getMSTime();
             m_dbEngine->Ping();
+
+            SqlDelayStats stats = GetStats();
+            DETAIL_LOG("SQL delay queue: %u queued (max %u), " UI64FMTD " executed in " UI64FMTD " batches, latency avg %u ms max %u ms",
+                       stats.queueDepth, stats.maxQueueDepth, stats.processed, stats.batches, stats.avgLatencyMs, stats.maxLatencyMs);
         }
     }
 
@@ -69,15 +117,118 @@ void SqlDelayThread::run()
 
 void SqlDelayThread::Stop()
 {
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_queueLock);
     m_running = false;
+    m_queueCond.signal();
 }
 
 void SqlDelayThread::ProcessRequests()
 {
-    SqlOperation* s = NULL;
-    while (m_sqlQueue.next(s))
+    SqlQueue queue;
+    {
+        ACE_GUARD(ACE_Thread_Mutex, guard, m_queueLock);
+        queue.swap(m_sqlQueue);
+    }
+
+    if (queue.empty())
+    {
+        return;
+    }
+
+    uint32 now = getMSTime();
+    uint64 latency = 0;
+    uint32 maxLatency = 0;
+    uint32 batches = 0;
+
+    // consecutive plain statements are coalesced into transactions, everything else keeps its place in the order
+    std::vector<SqlOperation*> batch;
+    for (SqlQueue::const_iterator itr = queue.begin(); itr != queue.end(); ++itr)
+    {
+        uint32 waited = getMSTimeDiff(itr->queueTime, now);
+        latency += waited;
+        maxLatency = std::max(maxLatency, waited);
+
+        if (m_batchSize > 1 && itr->op->IsBatchable())
+        {
+            batch.push_back(itr->op);
+            if (batch.size() >= m_batchSize)
+            {
+                ExecuteBatch(batch);
+                ++batches;
+            }
+            continue;
+        }
+
+        if (!batch.empty())
+        {
+            ExecuteBatch(batch);
+            ++batches;
+        }
+
+        itr->op->Execute(m_dbConnection);
+        delete itr->op;
+    }
+
+    if (!batch.empty())
+    {
+        ExecuteBatch(batch);
+        ++batches;
+    }
+
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_queueLock);
+    m_stats.processed += queue.size();
+    m_stats.batches += batches;
+    m_stats.maxLatencyMs = std::max(m_stats.maxLatencyMs, maxLatency);
+    m_totalLatencyMs += latency;
+}
+
+void SqlDelayThread::ExecuteBatch(std::vector<SqlOperation*>& batch)
+{
+    if (batch.size() > 1)
+    {
+        SqlConnection::Lock guard(m_dbConnection);
+
+        size_t failed = batch.size();
+        m_dbConnection->BeginTransaction();
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            if (!batch[i]->Execute(m_dbConnection))
+            {
+                failed = i;
+                break;
+            }
+        }
+
+        bool replay = true;
+        if (failed < batch.size())
+        {
+            m_dbConnection->RollbackTransaction();
+        }
+        else
+        {
+            replay = !m_dbConnection->CommitTransaction();
+        }
+
+        // a failing statement must not take the others with it, replay them one by one as they were queued
+        if (replay)
+        {
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                if (i != failed)
+                {
+                    batch[i]->Execute(m_dbConnection);
+                }
+            }
+        }
+    }
+    else
+    {
+        batch[0]->Execute(m_dbConnection);
+    }
+
+    for (size_t i = 0; i < batch.size(); ++i)
     {
-        s->Execute(m_dbConnection);
-        delete s;
+        delete batch[i];
     }
+    batch.clear();
 }
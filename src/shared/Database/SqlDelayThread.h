@@ -25,37 +25,76 @@
 #ifndef MANGOS_H_SQLDELAYTHREAD
 #define MANGOS_H_SQLDELAYTHREAD
 
+#include "Platform/Define.h"
 #include <ace/Thread_Mutex.h>
-#include "LockedQueue/LockedQueue.h"
+#include <ace/Condition_Thread_Mutex.h>
 #include "Threading/Threading.h"
 
+#include <deque>
+#include <vector>
+
 class Database;
 class SqlOperation;
 class SqlConnection;
 
+/**
+ * @brief Snapshot of the delay queue counters
+ *
+ */
+struct SqlDelayStats
+{
+    uint32 queueDepth;                                      /**< operations currently waiting */
+    uint32 maxQueueDepth;                                   /**< highest number of waiting operations seen */
+    uint64 processed;                                       /**< operations executed */
+    uint64 batches;                                         /**< transactions built from coalesced statements */
+    uint32 avgLatencyMs;                                    /**< average time from queueing to execution */
+    uint32 maxLatencyMs;                                    /**< longest time from queueing to execution */
+};
+
 /**
  * @brief
  *
  */
 class SqlDelayThread : public ACE_Based::Runnable
 {
+        /**
+         * @brief Queued operation with the time it was queued at
+         *
+         */
+        struct QueuedOperation
+        {
+            SqlOperation* op; /**< TODO */
+            uint32 queueTime; /**< TODO */
+        };
+
         /**
          * @brief
          *
          */
-        typedef ACE_Based::LockedQueue<SqlOperation*, ACE_Thread_Mutex> SqlQueue;
+        typedef std::deque<QueuedOperation> SqlQueue;
 
     private:
         SqlQueue m_sqlQueue;                                /**< Queue of SQL statements */
+        ACE_Thread_Mutex m_queueLock;                       /**< Guards the queue and the counters */
+        ACE_Condition_Thread_Mutex m_queueCond;             /**< Signalled when work is queued or the thread stops */
         Database* m_dbEngine;                               /**< Pointer to used Database engine */
         SqlConnection* m_dbConnection;                      /**< Pointer to DB connection */
         volatile bool m_running; /**< TODO */
+        uint32 m_batchSize;                                 /**< Max statements coalesced into one transaction */
+        SqlDelayStats m_stats; /**< TODO */
+        uint64 m_totalLatencyMs; /**< TODO */
 
         /**
          * @brief process all enqueued requests
          *
          */
         void ProcessRequests();
+        /**
+         * @brief Execute plain statements in one transaction, one by one if it fails
+         *
+         * @param batch
+         */
+        void ExecuteBatch(std::vector<SqlOperation*>& batch);
 
     public:
         /**
@@ -63,8 +102,9 @@ class SqlDelayThread : public ACE_Based::Runnable
          *
          * @param db
          * @param conn
+         * @param batchSize
          */
-        SqlDelayThread(Database* db, SqlConnection* conn);
+        SqlDelayThread(Database* db, SqlConnection* conn, uint32 batchSize = 1);
         /**
          * @brief
          *
@@ -77,7 +117,14 @@ class SqlDelayThread : public ACE_Based::Runnable
          * @param sql
          * @return bool
          */
-        bool Delay(SqlOperation* sql) { m_sqlQueue.add(sql); return true; }
+        bool Delay(SqlOperation* sql);
+
+        /**
+         * @brief Current queue counters
+         *
+         * @return SqlDelayStats
+         */
+        SqlDelayStats GetStats();
 
         /**
          * @brief Stop event
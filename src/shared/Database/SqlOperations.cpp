@@ -29,6 +29,33 @@
 
 #define LOCK_DB_CONN(conn) SqlConnection::Lock guard(conn)
 
+bool SqlCommitsImplicitly(const char* sql)
+{
+    // statements MySQL commits the current transaction for, a rollback of the batch would not undo them
+    static char const* const commands[] =
+    {
+        "ALTER", "CREATE", "DROP", "RENAME", "TRUNCATE", "LOCK", "UNLOCK", "GRANT", "REVOKE",
+        "ANALYZE", "OPTIMIZE", "REPAIR", "CACHE", "FLUSH", "RESET", "LOAD", "INSTALL", "UNINSTALL",
+        "START", "BEGIN", "COMMIT", "SET"
+    };
+
+    while (*sql && isspace((unsigned char)*sql))
+    {
+        ++sql;
+    }
+
+    for (size_t i = 0; i < sizeof(commands) / sizeof(commands[0]); ++i)
+    {
+        size_t len = strlen(commands[i]);
+        if (strnicmp(sql, commands[i], len) == 0 && !isalnum((unsigned char)sql[len]) && sql[len] != '_')
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /// ---- ASYNC STATEMENTS / TRANSACTIONS ----
 
 bool SqlPlainRequest::Execute(SqlConnection* conn)
@@ -39,6 +39,14 @@ class SqlConnection;
 class SqlDelayThread;
 class SqlStmtParameters;
 
+/**
+ * @brief checks if the statement commits the running transaction by itself (DDL, LOCK TABLES, ...)
+ *
+ * @param sql
+ * @return bool
+ */
+bool SqlCommitsImplicitly(const char* sql);
+
 /**
  * @brief
  *
@@ -58,6 +66,12 @@ class SqlOperation
          * @return bool
          */
         virtual bool Execute(SqlConnection* conn) = 0;
+        /**
+         * @brief Plain statements without results may be coalesced into one transaction by the delay thread
+         *
+         * @return bool
+         */
+        virtual bool IsBatchable() const { return false; }
         /**
          * @brief
          *
@@ -75,13 +89,14 @@ class SqlPlainRequest : public SqlOperation
 {
     private:
         const char* m_sql; /**< TODO */
+        bool m_batchable; /**< false for statements that would commit a batch halfway */
     public:
         /**
          * @brief
          *
          * @param sql
          */
-        SqlPlainRequest(const char* sql) : m_sql(mangos_strdup(sql)) {}
+        SqlPlainRequest(const char* sql) : m_sql(mangos_strdup(sql)), m_batchable(!SqlCommitsImplicitly(sql)) {}
         /**
          * @brief
          *
@@ -94,6 +109,12 @@ class SqlPlainRequest : public SqlOperation
          * @return bool
          */
         bool Execute(SqlConnection* conn) override;
+        /**
+         * @brief
+         *
+         * @return bool
+         */
+        bool IsBatchable() const override { return m_batchable; }
 };
 
 /**
@@ -160,6 +181,12 @@ class SqlPreparedRequest : public SqlOperation
          * @return bool
          */
         bool Execute(SqlConnection* conn) override;
+        /**
+         * @brief
+         *
+         * @return bool
+         */
+        bool IsBatchable() const override { return true; }
 
     private:
         const int m_nIndex; /**< TODO */
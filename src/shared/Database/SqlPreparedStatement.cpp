@@ -93,6 +93,74 @@ bool SqlStatement::DirectExecute()
     return m_pDB->DirectExecuteStmt(m_index, args);
 }
 
+//////////////////////////////////////////////////////////////////////////
+SqlBatchStatement::SqlBatchStatement(Database& db, SqlBatchStatementID& index, const char* head, const char* row, const char* tail) :
+    m_db(db), m_index(index), m_head(head), m_row(row), m_tail(tail)
+{
+    m_headParams = std::count(m_head.begin(), m_head.end(), '?');
+    m_rowParams = std::count(m_row.begin(), m_row.end(), '?');
+    MANGOS_ASSERT(m_rowParams > 0 && std::count(m_tail.begin(), m_tail.end(), '?') == 0);
+}
+
+bool SqlBatchStatement::Execute()
+{
+    bool result = true;
+    size_t rows = m_params.size() / m_rowParams;
+    size_t firstParam = 0;
+
+    // full chunks first, then the rest as the largest possible power of two chunks
+    for (int chunk = SQL_BATCH_STATEMENTS - 1; chunk >= 0; --chunk)
+    {
+        size_t chunkRows = size_t(1) << chunk;
+        while (rows >= chunkRows)
+        {
+            result &= ExecuteChunk(chunk, firstParam);
+            rows -= chunkRows;
+            firstParam += chunkRows * m_rowParams;
+        }
+    }
+
+    m_params.clear();
+    return result;
+}
+
+bool SqlBatchStatement::ExecuteChunk(uint32 chunk, size_t firstParam)
+{
+    uint32 rows = 1 << chunk;
+    SqlStatementID& index = m_index.chunks[chunk];
+
+    std::string fmt;
+    if (!index.initialized())
+    {
+        fmt.reserve(m_head.size() + rows * (m_row.size() + 2) + m_tail.size());
+        fmt = m_head;
+        for (uint32 i = 0; i < rows; ++i)
+        {
+            if (i)
+            {
+                fmt += ", ";
+            }
+            fmt += m_row;
+        }
+        fmt += m_tail;
+    }
+
+    SqlStatement stmt = m_db.CreateStatement(index, fmt.c_str());
+    SqlStmtParameters* params = stmt.get();
+
+    for (SqlStmtParameters::ParameterContainer::const_iterator itr = m_headValues.begin(); itr != m_headValues.end(); ++itr)
+    {
+        params->addParam(*itr);
+    }
+
+    for (size_t i = 0; i < rows * m_rowParams; ++i)
+    {
+        params->addParam(m_params[firstParam + i]);
+    }
+
+    return stmt.Execute();
+}
+
 //////////////////////////////////////////////////////////////////////////
 SqlPlainPreparedStatement::SqlPlainPreparedStatement(const std::string& fmt, SqlConnection& conn) : SqlPreparedStatement(fmt, conn)
 {
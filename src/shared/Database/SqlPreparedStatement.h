@@ -639,6 +639,7 @@ class SqlStatement
     protected:
         // don't allow anyone except Database class to create static SqlStatement objects
         friend class Database;
+        friend class SqlBatchStatement;
         /**
          * @brief
          *
@@ -695,6 +696,96 @@ class SqlStatement
         SqlStmtParameters* m_pParams; /**< TODO */
 };
 
+#define SQL_BATCH_MAX_ROWS      32                          // rows per statement, must be a power of two
+#define SQL_BATCH_STATEMENTS    6                           // log2(SQL_BATCH_MAX_ROWS) + 1 chunk sizes
+
+/**
+ * @brief statement ids of all chunk sizes of one batch statement
+ *
+ */
+struct SqlBatchStatementID
+{
+    SqlStatementID chunks[SQL_BATCH_STATEMENTS]; /**< index n holds the statement for 1 << n rows */
+};
+
+/**
+ * @brief collects rows of a multi-row statement and executes them in few round-trips
+ *
+ * The statement text is head + row repeated for every row (comma separated) + tail, e.g.
+ * "INSERT INTO t (a, b) VALUES " + "(?, ?)" or "DELETE FROM t WHERE guid = ? AND id IN (" + "?" + ")".
+ * The first parameters bound fill the placeholders of head, all further ones are rows.
+ * Nothing is sent before Execute(), which queues chunks of SQL_BATCH_MAX_ROWS rows and
+ * splits the rest into power of two chunks, so only SQL_BATCH_STATEMENTS distinct
+ * statements are ever prepared per batch. Several batches therefore keep their relative
+ * order when executed one after another.
+ */
+class SqlBatchStatement
+{
+    public:
+        /**
+         * @brief
+         *
+         * @param db
+         * @param index
+         * @param head
+         * @param row
+         * @param tail
+         */
+        SqlBatchStatement(Database& db, SqlBatchStatementID& index, const char* head, const char* row, const char* tail = "");
+
+        /**
+         * @brief execute all bound rows
+         *
+         * @return bool
+         */
+        bool Execute();
+
+        /**
+         * @brief
+         *
+         * @return uint32 number of rows bound and not executed yet
+         */
+        uint32 GetRowCount() const { return m_params.size() / m_rowParams; }
+
+        // bind parameters with specified type
+        void addBool(bool var) { arg(var); }
+        void addUInt8(uint8 var) { arg(var); }
+        void addInt8(int8 var) { arg(var); }
+        void addUInt16(uint16 var) { arg(var); }
+        void addInt16(int16 var) { arg(var); }
+        void addUInt32(uint32 var) { arg(var); }
+        void addInt32(int32 var) { arg(var); }
+        void addUInt64(uint64 var) { arg(var); }
+        void addInt64(int64 var) { arg(var); }
+        void addFloat(float var) { arg(var); }
+        void addDouble(double var) { arg(var); }
+
+    private:
+        template<typename ParamType>
+        void arg(ParamType val)
+        {
+            if (m_headValues.size() < m_headParams)
+            {
+                m_headValues.push_back(SqlStmtFieldData(val));
+                return;
+            }
+
+            m_params.push_back(SqlStmtFieldData(val));
+        }
+
+        bool ExecuteChunk(uint32 chunk, size_t firstParam);
+
+        Database& m_db; /**< TODO */
+        SqlBatchStatementID& m_index; /**< TODO */
+        std::string m_head; /**< TODO */
+        std::string m_row; /**< TODO */
+        std::string m_tail; /**< TODO */
+        uint32 m_headParams; /**< placeholders in m_head */
+        uint32 m_rowParams; /**< placeholders in m_row */
+        SqlStmtParameters::ParameterContainer m_headValues; /**< TODO */
+        SqlStmtParameters::ParameterContainer m_params; /**< row parameters not executed yet */
+};
+
 /**
  * @brief base prepared statement class
  *
@@ -29,12 +29,15 @@
 #include "Utilities/Util.h"
 #include "Utilities/ByteBuffer.h"
 #include "Utilities/ProgressBar.h"
+#include "LogWriter.h"
 
 #include <stdarg.h>
+#include <signal.h>
 #include <fstream>
 #include <iostream>
 
 #include <ace/OS_NS_unistd.h>
+#include <ace/Guard_T.h>
 
 INSTANTIATE_SINGLETON_1(Log);
 
@@ -72,6 +75,17 @@ enum LogType
 
 const int LogType_count = int(LogError) + 1;
 
+// records up to this size are formatted on the stack before being queued
+#define LOG_RECORD_BUFFER_SIZE 2048
+
+std::atomic<LogWriter*> Log::s_crashWriter(NULL);
+
+// fatal signals that flush the async writer, and the handlers that were installed before
+static int const s_crashSignals[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL };
+static int const s_crashSignalCount = sizeof(s_crashSignals) / sizeof(s_crashSignals[0]);
+static void (*s_prevCrashHandlers[s_crashSignalCount])(int);
+static bool s_crashHandlersInstalled = false;
+
 Log::Log() :
     raLogfile(NULL), logfile(NULL), gmLogfile(NULL), charLogfile(NULL), dberLogfile(NULL),
 #ifdef ENABLE_ELUNA
@@ -79,7 +93,7 @@ Log::Log() :
 #endif /* ENABLE_ELUNA */
 
     eventAiErLogfile(NULL), scriptErrLogFile(NULL), worldLogfile(NULL), wardenLogfile(NULL), m_colored(false),
-    m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(NULL)
+    m_includeTime(false), m_gmlog_per_account(false), m_scriptLibName(NULL), m_asyncWriter(NULL), m_asyncThread(NULL), m_asyncEnabled(false)
 {
     Initialize();
 }
@@ -318,6 +332,9 @@ void Log::Initialize()
 
     // Char log settings
     m_charLog_Dump = sConfig.GetBoolDefault("CharLogDump", false);
+
+    // Background writer for log files
+    startAsyncWriter();
 }
 
 FILE* Log::openLogFile(char const* configFileName, char const* configTimeStampFlag, char const* mode)
@@ -370,6 +387,225 @@ void Log::outTimestamp(FILE* file)
     fprintf(file, "%-4d-%02d-%02d %02d:%02d:%02d ", aTm.tm_year + 1900, aTm.tm_mon + 1, aTm.tm_mday, aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
 }
 
+int Log::formatTimestamp(char* buf, size_t size)
+{
+    time_t tt = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm aTm = localtime_r(tt);
+
+    // same layout as outTimestamp()
+    return snprintf(buf, size, "%-4d-%02d-%02d %02d:%02d:%02d ", aTm.tm_year + 1900, aTm.tm_mon + 1, aTm.tm_mday, aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
+}
+
+void Log::outFile(FILE* file, char const* prefix, char const* str, va_list* ap)
+{
+    if (m_asyncEnabled)
+    {
+        ACE_READ_GUARD(ACE_RW_Thread_Mutex, guard, m_asyncWriterLock);
+
+        // the writer may just be stopping
+        if (m_asyncWriter)
+        {
+            // format on the calling thread, the writer thread only does the I/O
+            char buf[LOG_RECORD_BUFFER_SIZE];
+            std::string record;
+
+            int len = formatTimestamp(buf, sizeof(buf));
+            record.append(buf, len);
+
+            if (prefix)
+            {
+                record.append(prefix);
+            }
+
+            if (str)
+            {
+                va_list ap2;
+                va_copy(ap2, *ap);
+                len = vsnprintf(buf, sizeof(buf), str, ap2);
+                va_end(ap2);
+
+                if (len >= int(sizeof(buf)))
+                {
+                    // rare long record, format it again straight into the string
+                    size_t offset = record.size();
+                    record.resize(offset + len + 1);
+
+                    va_copy(ap2, *ap);
+                    vsnprintf(&record[offset], len + 1, str, ap2);
+                    va_end(ap2);
+
+                    record.resize(offset + len);
+                }
+                else if (len > 0)
+                {
+                    record.append(buf, len);
+                }
+            }
+
+            record.push_back('\n');
+
+            m_asyncWriter->Add(file, record);
+            return;
+        }
+    }
+
+    outTimestamp(file);
+
+    if (prefix)
+    {
+        fputs(prefix, file);
+    }
+
+    if (str)
+    {
+        va_list ap2;
+        va_copy(ap2, *ap);
+        vfprintf(file, str, ap2);
+        va_end(ap2);
+    }
+
+    fprintf(file, "\n");
+    fflush(file);
+}
+
+void Log::outFileRaw(FILE* file, std::string& text)
+{
+    if (m_asyncEnabled)
+    {
+        ACE_READ_GUARD(ACE_RW_Thread_Mutex, guard, m_asyncWriterLock);
+
+        if (m_asyncWriter)
+        {
+            m_asyncWriter->Add(file, text);
+            return;
+        }
+    }
+
+    fwrite(text.data(), 1, text.size(), file);
+    fflush(file);
+}
+
+void Log::startAsyncWriter()
+{
+    stopAsyncWriter();
+
+    if (!sConfig.GetBoolDefault("LogAsync", false))
+    {
+        return;
+    }
+
+    int queueSize = sConfig.GetIntDefault("LogAsync.QueueSize", 10000);
+    if (queueSize < 100)
+    {
+        queueSize = 100;
+    }
+
+    {
+        ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_asyncWriterLock);
+
+        m_asyncWriter = new LogWriter(size_t(queueSize), logfile);
+        m_asyncThread = new ACE_Based::Thread(m_asyncWriter);
+        s_crashWriter = m_asyncWriter;
+        m_asyncEnabled = true;
+    }
+
+    // flush queued records if the process goes down on a signal, then pass the signal on
+    // to whatever handled it before (a crash dumper, or the default action)
+    if (!s_crashHandlersInstalled)
+    {
+        s_crashHandlersInstalled = true;
+        for (int i = 0; i < s_crashSignalCount; ++i)
+        {
+            s_prevCrashHandlers[i] = signal(s_crashSignals[i], &Log::onCrashSignal);
+        }
+    }
+}
+
+void Log::stopAsyncWriter()
+{
+    LogWriter* writer;
+    ACE_Based::Thread* thread;
+    {
+        // waits for threads still queueing into the writer, new records go straight to the files from now on
+        ACE_WRITE_GUARD(ACE_RW_Thread_Mutex, guard, m_asyncWriterLock);
+
+        if (!m_asyncThread)
+        {
+            return;
+        }
+
+        writer = m_asyncWriter;
+        thread = m_asyncThread;
+        s_crashWriter = NULL;
+        m_asyncWriter = NULL;
+        m_asyncThread = NULL;
+        m_asyncEnabled = false;
+    }
+
+    writer->Stop();
+    thread->wait();
+
+    if (uint32 dropped = writer->GetDroppedCount())
+    {
+        if (logfile)
+        {
+            fprintf(logfile, "LOG: async writer dropped %u records in total, queue depth peaked at %u\n", dropped, writer->GetMaxQueueDepth());
+            fflush(logfile);
+        }
+    }
+
+    delete thread;                                          // this also deletes the writer
+}
+
+void Log::Flush()
+{
+    if (!m_asyncEnabled)
+    {
+        return;
+    }
+
+    ACE_READ_GUARD(ACE_RW_Thread_Mutex, guard, m_asyncWriterLock);
+
+    if (LogWriter* writer = m_asyncWriter)
+    {
+        writer->Flush();
+    }
+}
+
+uint32 Log::GetAsyncDroppedCount() const
+{
+    if (!m_asyncEnabled)
+    {
+        return 0;
+    }
+
+    ACE_READ_GUARD_RETURN(ACE_RW_Thread_Mutex, guard, m_asyncWriterLock, 0);
+
+    return m_asyncWriter ? m_asyncWriter->GetDroppedCount() : 0;
+}
+
+void Log::onCrashSignal(int s)
+{
+    // sLog and its locks may be held by the crashing thread, only the writer is touched here
+    if (LogWriter* writer = s_crashWriter)
+    {
+        writer->FlushFromCrashHandler();
+    }
+
+    // hand the signal to the previous handler, an ignored fatal signal would only fault again
+    void (*prev)(int) = SIG_DFL;
+    for (int i = 0; i < s_crashSignalCount; ++i)
+    {
+        if (s_crashSignals[i] == s && s_prevCrashHandlers[i] != SIG_ERR && s_prevCrashHandlers[i] != SIG_IGN)
+        {
+            prev = s_prevCrashHandlers[i];
+        }
+    }
+
+    signal(s, prev);
+    raise(s);
+}
+
 void Log::outTime()
 {
     time_t tt = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
@@ -409,9 +645,7 @@ void Log::outString()
     printf("\n");
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "\n");
-        fflush(logfile);
+        outFile(logfile, NULL, NULL, NULL);
     }
 
     fflush(stdout);
@@ -449,14 +683,9 @@ void Log::outString(const char* str, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
+        outFile(logfile, NULL, str, &ap);
         va_end(ap);
-
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -493,15 +722,9 @@ void Log::outError(const char* err, ...)
     fprintf(stderr, "\n");
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        outFile(logfile, "ERROR:", err, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     fflush(stderr);
@@ -518,16 +741,12 @@ void Log::outErrorDb()
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:\n");
-        fflush(logfile);
+        outFile(logfile, "ERROR:", NULL, NULL);
     }
 
     if (dberLogfile)
     {
-        outTimestamp(dberLogfile);
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
+        outFile(dberLogfile, NULL, NULL, NULL);
     }
 
     fflush(stderr);
@@ -565,28 +784,17 @@ void Log::outErrorDb(const char* err, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR:");
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        outFile(logfile, "ERROR:", err, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     if (dberLogfile)
     {
-        outTimestamp(dberLogfile);
-
         va_list ap;
         va_start(ap, err);
-        vfprintf(dberLogfile, err, ap);
+        outFile(dberLogfile, NULL, err, &ap);
         va_end(ap);
-
-        fprintf(dberLogfile, "\n");
-        fflush(dberLogfile);
     }
 
     fflush(stderr);
@@ -604,16 +812,12 @@ void Log::outErrorEluna()
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR Eluna\n");
-        fflush(logfile);
+        outFile(logfile, "ERROR Eluna", NULL, NULL);
     }
 
     if (elunaErrLogfile)
     {
-        outTimestamp(elunaErrLogfile);
-        fprintf(elunaErrLogfile, "\n");
-        fflush(elunaErrLogfile);
+        outFile(elunaErrLogfile, NULL, NULL, NULL);
     }
 
     fflush(stderr);
@@ -656,28 +860,17 @@ void Log::outErrorEluna(const char* err, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR Eluna: ");
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        outFile(logfile, "ERROR Eluna: ", err, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     if (elunaErrLogfile)
     {
-        outTimestamp(elunaErrLogfile);
-
         va_list ap;
         va_start(ap, err);
-        vfprintf(elunaErrLogfile, err, ap);
+        outFile(elunaErrLogfile, NULL, err, &ap);
         va_end(ap);
-
-        fprintf(elunaErrLogfile, "\n");
-        fflush(elunaErrLogfile);
     }
 
     fflush(stderr);
@@ -698,16 +891,12 @@ void Log::outErrorEventAI()
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI\n");
-        fflush(logfile);
+        outFile(logfile, "ERROR CreatureEventAI", NULL, NULL);
     }
 
     if (eventAiErLogfile)
     {
-        outTimestamp(eventAiErLogfile);
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
+        outFile(eventAiErLogfile, NULL, NULL, NULL);
     }
 
     fflush(stderr);
@@ -745,28 +934,17 @@ void Log::outErrorEventAI(const char* err, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        fprintf(logfile, "ERROR CreatureEventAI: ");
-
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        outFile(logfile, "ERROR CreatureEventAI: ", err, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     if (eventAiErLogfile)
     {
-        outTimestamp(eventAiErLogfile);
-
         va_list ap;
         va_start(ap, err);
-        vfprintf(eventAiErLogfile, err, ap);
+        outFile(eventAiErLogfile, NULL, err, &ap);
         va_end(ap);
-
-        fprintf(eventAiErLogfile, "\n");
-        fflush(eventAiErLogfile);
     }
 
     fflush(stderr);
@@ -807,12 +985,9 @@ void Log::outBasic(const char* str, ...)
     if (logfile && m_logFileLevel >= LOG_LVL_BASIC)
     {
         va_list ap;
-        outTimestamp(logfile);
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
+        outFile(logfile, NULL, str, &ap);
         va_end(ap);
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -852,15 +1027,10 @@ void Log::outDetail(const char* str, ...)
 
     if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
     {
-        outTimestamp(logfile);
-
         va_list ap;
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
+        outFile(logfile, NULL, str, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -900,15 +1070,10 @@ void Log::outDebug(const char* str, ...)
 
     if (logfile && m_logFileLevel >= LOG_LVL_DEBUG)
     {
-        outTimestamp(logfile);
-
         va_list ap;
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
+        outFile(logfile, NULL, str, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     fflush(stdout);
@@ -949,16 +1114,14 @@ void Log::outCommand(uint32 account, const char* str, ...)
     if (logfile && m_logFileLevel >= LOG_LVL_DETAIL)
     {
         va_list ap;
-        outTimestamp(logfile);
         va_start(ap, str);
-        vfprintf(logfile, str, ap);
-        fprintf(logfile, "\n");
+        outFile(logfile, NULL, str, &ap);
         va_end(ap);
-        fflush(logfile);
     }
 
     if (m_gmlog_per_account)
     {
+        // per account files are opened for a single record only, always written directly
         if (FILE* per_file = openGmlogPerAccount(account))
         {
             va_list ap;
@@ -973,12 +1136,9 @@ void Log::outCommand(uint32 account, const char* str, ...)
     else if (gmLogfile)
     {
         va_list ap;
-        outTimestamp(gmLogfile);
         va_start(ap, str);
-        vfprintf(gmLogfile, str, ap);
-        fprintf(gmLogfile, "\n");
+        outFile(gmLogfile, NULL, str, &ap);
         va_end(ap);
-        fflush(gmLogfile);
     }
 
     fflush(stdout);
@@ -993,9 +1153,7 @@ void Log::outWarden()
     printf("\n");
     if (wardenLogfile)
     {
-        outTimestamp(wardenLogfile);
-        fprintf(wardenLogfile, "\n");
-        fflush(wardenLogfile);
+        outFile(wardenLogfile, NULL, NULL, NULL);
     }
 
     fflush(stdout);
@@ -1036,16 +1194,9 @@ void Log::outWarden(const char* str, ...)
     if (wardenLogfile && m_logFileLevel >= LOG_LVL_DETAIL)
     {
         va_list ap;
-
-        outTimestamp(wardenLogfile);
-        fprintf(wardenLogfile, "[Warden]: ");
-
         va_start(ap, str);
-        vfprintf(wardenLogfile, str, ap);
-        fprintf(wardenLogfile, "\n");
+        outFile(wardenLogfile, "[Warden]: ", str, &ap);
         va_end(ap);
-
-        fflush(wardenLogfile);
     }
 
     fflush(stdout);
@@ -1061,12 +1212,9 @@ void Log::outChar(const char* str, ...)
     if (charLogfile)
     {
         va_list ap;
-        outTimestamp(charLogfile);
         va_start(ap, str);
-        vfprintf(charLogfile, str, ap);
-        fprintf(charLogfile, "\n");
+        outFile(charLogfile, NULL, str, &ap);
         va_end(ap);
-        fflush(charLogfile);
     }
 }
 
@@ -1081,23 +1229,13 @@ void Log::outErrorScriptLib()
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        if (m_scriptLibName)
-        {
-            fprintf(logfile, "<%s ERROR:> ", m_scriptLibName);
-        }
-        else
-        {
-            fprintf(logfile, "<Scripting Library ERROR>: ");
-        }
-        fflush(logfile);
+        std::string prefix = m_scriptLibName ? std::string("<") + m_scriptLibName + " ERROR:> " : "<Scripting Library ERROR>: ";
+        outFile(logfile, prefix.c_str(), NULL, NULL);
     }
 
     if (scriptErrLogFile)
     {
-        outTimestamp(scriptErrLogFile);
-        fprintf(scriptErrLogFile, "\n");
-        fflush(scriptErrLogFile);
+        outFile(scriptErrLogFile, NULL, NULL, NULL);
     }
 
     fflush(stderr);
@@ -1135,35 +1273,19 @@ void Log::outErrorScriptLib(const char* err, ...)
 
     if (logfile)
     {
-        outTimestamp(logfile);
-        if (m_scriptLibName)
-        {
-            fprintf(logfile, "<%s ERROR>: ", m_scriptLibName);
-        }
-        else
-        {
-            fprintf(logfile, "<Scripting Library ERROR>: ");
-        }
+        std::string prefix = m_scriptLibName ? std::string("<") + m_scriptLibName + " ERROR>: " : "<Scripting Library ERROR>: ";
 
         va_start(ap, err);
-        vfprintf(logfile, err, ap);
+        outFile(logfile, prefix.c_str(), err, &ap);
         va_end(ap);
-
-        fprintf(logfile, "\n");
-        fflush(logfile);
     }
 
     if (scriptErrLogFile)
     {
-        outTimestamp(scriptErrLogFile);
-
         va_list ap;
         va_start(ap, err);
-        vfprintf(scriptErrLogFile, err, ap);
+        outFile(scriptErrLogFile, NULL, err, &ap);
         va_end(ap);
-
-        fprintf(scriptErrLogFile, "\n");
-        fflush(scriptErrLogFile);
     }
 
     fflush(stderr);
@@ -1176,35 +1298,46 @@ void Log::outWorldPacketDump(uint32 socket, uint32 opcode, char const* opcodeNam
         return;
     }
 
-    ACE_GUARD(ACE_Thread_Mutex, GuardObj, m_worldLogMtx);
+    // the whole dump is built first so it reaches the file as one record
+    char buf[256];
+    std::string dump;
+    dump.reserve(128 + packet->size() * 3 + packet->size() / 16);
 
-    outTimestamp(worldLogfile);
+    formatTimestamp(buf, sizeof(buf));
+    dump.append(buf);
 
-    fprintf(worldLogfile, "\n%s:\nSOCKET: %u\nLENGTH: " SIZEFMTD "\nOPCODE: %s (0x%.4X)\nDATA:\n",
-            incoming ? "CLIENT" : "SERVER",
-            socket, packet->size(), opcodeName, opcode);
+    snprintf(buf, sizeof(buf), "\n%s:\nSOCKET: %u\nLENGTH: " SIZEFMTD "\nOPCODE: %s (0x%.4X)\nDATA:\n",
+             incoming ? "CLIENT" : "SERVER",
+             socket, packet->size(), opcodeName, opcode);
+    dump.append(buf);
 
     size_t p = 0;
     while (p < packet->size())
     {
         for (size_t j = 0; j < 16 && p < packet->size(); ++j)
         {
-            fprintf(worldLogfile, "%.2X ", (*packet)[p++]);
+            snprintf(buf, sizeof(buf), "%.2X ", (*packet)[p++]);
+            dump.append(buf);
         }
 
-        fprintf(worldLogfile, "\n");
+        dump.append("\n");
     }
 
-    fprintf(worldLogfile, "\n\n");
-    fflush(worldLogfile);
+    dump.append("\n\n");
+
+    ACE_GUARD(ACE_Thread_Mutex, GuardObj, m_worldLogMtx);
+    outFileRaw(worldLogfile, dump);
 }
 
 void Log::outCharDump(const char* str, uint32 account_id, uint32 guid, const char* name)
 {
     if (charLogfile)
     {
-        fprintf(charLogfile, "== START DUMP == (account: %u guid: %u name: %s )\n%s\n== END DUMP ==\n", account_id, guid, name, str);
-        fflush(charLogfile);
+        std::string dump("== START DUMP == (account: ");
+        dump.append(std::to_string(account_id)).append(" guid: ").append(std::to_string(guid));
+        dump.append(" name: ").append(name).append(" )\n").append(str).append("\n== END DUMP ==\n");
+
+        outFileRaw(charLogfile, dump);
     }
 }
 
@@ -1218,12 +1351,9 @@ void Log::outRALog(const char* str, ...)
     if (raLogfile)
     {
         va_list ap;
-        outTimestamp(raLogfile);
         va_start(ap, str);
-        vfprintf(raLogfile, str, ap);
-        fprintf(raLogfile, "\n");
+        outFile(raLogfile, NULL, str, &ap);
         va_end(ap);
-        fflush(raLogfile);
     }
 
     fflush(stdout);
@@ -28,8 +28,14 @@
 #include "Common/Common.h"
 #include "Policies/Singleton.h"
 
+#include <ace/RW_Thread_Mutex.h>
+
+#include <atomic>
+#include <stdarg.h>
+
 class Config;
 class ByteBuffer;
+class LogWriter;
 
 /**
  * @brief various levels for logging
@@ -130,6 +136,9 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
          */
         ~Log()
         {
+            // write out everything still queued before the files go away
+            stopAsyncWriter();
+
             if (logfile != NULL)
             {
                 fclose(logfile);
@@ -432,7 +441,61 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
          */
         void setScriptLibraryErrorFile(char const* fname, char const* libName);
 
+        /**
+         * @brief block until all records queued for the async writer are written
+         *
+         */
+        void Flush();
+
+        /**
+         * @brief
+         *
+         * @return uint32 records dropped because the async queue was full
+         */
+        uint32 GetAsyncDroppedCount() const;
+
     private:
+        /**
+         * @brief write a timestamped record to a log file, directly or through the async writer
+         *
+         * @param file
+         * @param prefix text written between timestamp and message, may be NULL
+         * @param str format string, may be NULL
+         * @param ap
+         */
+        void outFile(FILE* file, char const* prefix, char const* str, va_list* ap);
+        /**
+         * @brief write preformatted text to a log file, the string is consumed in async mode
+         *
+         * @param file
+         * @param text
+         */
+        void outFileRaw(FILE* file, std::string& text);
+        /**
+         * @brief
+         *
+         * @param buf
+         * @param size
+         * @return int length of the timestamp written to buf
+         */
+        static int formatTimestamp(char* buf, size_t size);
+        /**
+         * @brief start the background writer if LogAsync is enabled
+         *
+         */
+        void startAsyncWriter();
+        /**
+         * @brief drain and stop the background writer
+         *
+         */
+        void stopAsyncWriter();
+        /**
+         * @brief writes pending async records before the process dies
+         *
+         * @param s
+         */
+        static void onCrashSignal(int s);
+
         /**
          * @brief
          *
@@ -484,6 +547,13 @@ class Log : public MaNGOS::Singleton<Log, MaNGOS::ClassLevelLockable<Log, ACE_Th
         std::string m_gmlog_filename_format; /**< TODO */
 
         char const* m_scriptLibName; /**< TODO */
+
+        // async log control
+        LogWriter* m_asyncWriter; /**< NULL when LogAsync is disabled, guarded by m_asyncWriterLock */
+        ACE_Based::Thread* m_asyncThread; /**< TODO */
+        mutable ACE_RW_Thread_Mutex m_asyncWriterLock; /**< read locked while m_asyncWriter is used, write locked to replace it */
+        std::atomic<bool> m_asyncEnabled; /**< LogAsync is on, without it log calls never touch m_asyncWriterLock */
+        static std::atomic<LogWriter*> s_crashWriter; /**< writer flushed by onCrashSignal, which must not touch sLog */
 };
 
 #define sLog MaNGOS::Singleton<Log>::Instance()
@@ -0,0 +1,195 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2021 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#include "LogWriter.h"
+#include "Log.h"
+
+#include <ace/Guard_T.h>
+
+#include <algorithm>
+
+#if PLATFORM == PLATFORM_WINDOWS
+#  include <io.h>
+#endif
+
+LogWriter::LogWriter(size_t maxQueued, FILE* reportFile) :
+    m_wakeup(m_lock), m_drained(m_lock), m_batchFlushed(true), m_maxQueued(maxQueued), m_reportFile(reportFile), m_running(true),
+    m_writing(false), m_dropped(0), m_reportedDropped(0), m_maxDepth(0)
+{
+    m_queue.reserve(m_maxQueued < 1024 ? m_maxQueued : 1024);
+    m_batch.reserve(m_queue.capacity());
+}
+
+LogWriter::~LogWriter()
+{
+    // anything still queued after the thread has gone is written here
+    WriteRecords(m_queue);
+}
+
+void LogWriter::run()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    for (;;)
+    {
+        while (m_running && m_queue.empty())
+        {
+            m_wakeup.wait();
+        }
+
+        if (m_queue.empty())
+        {
+            break;                                          // stopped and drained
+        }
+
+        m_batch.swap(m_queue);
+        m_batchFlushed = false;
+        m_writing = true;
+
+        if (uint32 dropped = m_dropped - m_reportedDropped)
+        {
+            m_reportedDropped = m_dropped;
+
+            LogRecord record;
+            record.file = m_reportFile ? m_reportFile : m_batch.front().file;
+            record.fd = fileno(record.file);
+            record.text = "LOG: async queue overflow, dropped " + std::to_string(dropped) + " records\n";
+            m_batch.push_back(record);
+        }
+
+        m_lock.release();
+
+        WriteRecords(m_batch);
+        m_batchFlushed = true;
+
+        m_lock.acquire();
+
+        m_batch.clear();
+        m_writing = false;
+        m_drained.broadcast();
+    }
+
+    m_drained.broadcast();
+}
+
+bool LogWriter::Add(FILE* file, std::string& text)
+{
+    ACE_GUARD_RETURN(ACE_Thread_Mutex, guard, m_lock, false);
+
+    if (m_queue.size() >= m_maxQueued)
+    {
+        ++m_dropped;
+        return false;
+    }
+
+    m_queue.push_back(LogRecord());
+    m_queue.back().file = file;
+    m_queue.back().fd = fileno(file);
+    m_queue.back().text.swap(text);
+
+    if (m_queue.size() > m_maxDepth)
+    {
+        m_maxDepth = uint32(m_queue.size());
+    }
+
+    // the writer only needs waking for the first record of a batch
+    if (m_queue.size() == 1)
+    {
+        m_wakeup.signal();
+    }
+
+    return true;
+}
+
+void LogWriter::Flush()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    while (m_running && (!m_queue.empty() || m_writing))
+    {
+        m_drained.wait();
+    }
+}
+
+void LogWriter::Stop()
+{
+    ACE_GUARD(ACE_Thread_Mutex, guard, m_lock);
+
+    m_running = false;
+    m_wakeup.signal();
+}
+
+void LogWriter::FlushFromCrashHandler()
+{
+    if (m_lock.tryacquire() == -1)
+    {
+        return;
+    }
+
+    // stdio and the allocator are off limits here, the records are written
+    // straight to their descriptors and left where they are. The batch the
+    // writer thread is busy with comes first; if it crashed halfway through,
+    // lines stdio already flushed on its own show up twice rather than not at all.
+    if (!m_batchFlushed)
+    {
+        WriteRecordsFromCrashHandler(m_batch);
+    }
+    WriteRecordsFromCrashHandler(m_queue);
+
+    m_lock.release();
+}
+
+void LogWriter::WriteRecordsFromCrashHandler(RecordList const& records)
+{
+    for (RecordList::const_iterator itr = records.begin(); itr != records.end(); ++itr)
+    {
+#if PLATFORM == PLATFORM_WINDOWS
+        _write(itr->fd, itr->text.data(), unsigned(itr->text.size()));
+#else
+        ssize_t written = write(itr->fd, itr->text.data(), itr->text.size());
+        (void)written;
+#endif
+    }
+}
+
+void LogWriter::WriteRecords(RecordList const& records)
+{
+    // only a handful of log files exist, a linear search is all we need
+    std::vector<FILE*> touched;
+
+    for (RecordList::const_iterator itr = records.begin(); itr != records.end(); ++itr)
+    {
+        fwrite(itr->text.data(), 1, itr->text.size(), itr->file);
+
+        if (std::find(touched.begin(), touched.end(), itr->file) == touched.end())
+        {
+            touched.push_back(itr->file);
+        }
+    }
+
+    for (std::vector<FILE*>::iterator itr = touched.begin(); itr != touched.end(); ++itr)
+    {
+        fflush(*itr);
+    }
+}
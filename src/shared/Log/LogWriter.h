@@ -0,0 +1,152 @@
+/**
+ * MaNGOS is a full featured server for World of Warcraft, supporting
+ * the following clients: 1.12.x, 2.4.3, 3.3.5a, 4.3.4a and 5.4.8
+ *
+ * Copyright (C) 2005-2021 MaNGOS <https://getmangos.eu>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * World of Warcraft, and all World of Warcraft or Warcraft art, images,
+ * and lore are copyrighted by Blizzard Entertainment, Inc.
+ */
+
+#ifndef MANGOSSERVER_LOGWRITER_H
+#define MANGOSSERVER_LOGWRITER_H
+
+#include "Common/Common.h"
+#include "Threading/Threading.h"
+
+#include <ace/Thread_Mutex.h>
+#include <ace/Condition_Thread_Mutex.h>
+
+#include <atomic>
+
+/**
+ * @brief one formatted log line (or block) waiting to be written
+ *
+ */
+struct LogRecord
+{
+    FILE* file; /**< destination log file */
+    int fd; /**< descriptor of file, looked up up front so the crash handler can write(2) to it */
+    std::string text; /**< fully formatted text, including timestamp and newline */
+};
+
+/**
+ * @brief Background writer used when LogAsync is enabled.
+ *
+ * Callers format their records on their own thread and only take the queue
+ * lock to move the finished string in. The writer thread swaps the whole
+ * queue out at once, writes it and flushes every touched file a single time
+ * per batch.
+ */
+class LogWriter : public ACE_Based::Runnable
+{
+    public:
+        /**
+         * @brief
+         *
+         * @param maxQueued records kept at most before new ones are dropped
+         * @param reportFile file receiving overflow reports, may be NULL
+         */
+        LogWriter(size_t maxQueued, FILE* reportFile);
+
+        /**
+         * @brief
+         *
+         */
+        ~LogWriter();
+
+        /**
+         * @brief writer thread body
+         *
+         */
+        void run();
+
+        /**
+         * @brief queue a record, the text is moved out of the passed string
+         *
+         * @param file
+         * @param text
+         * @return bool false if the queue was full and the record got dropped
+         */
+        bool Add(FILE* file, std::string& text);
+
+        /**
+         * @brief block until everything queued so far has reached the files
+         *
+         */
+        void Flush();
+
+        /**
+         * @brief write everything queued so far and let run() return
+         *
+         */
+        void Stop();
+
+        /**
+         * @brief write whatever is queued from the calling thread, used on crash
+         *
+         * Does not wait for the queue lock, a crashing thread may be holding it,
+         * and only uses write(2) so it is safe to call from a signal handler.
+         */
+        void FlushFromCrashHandler();
+
+        /**
+         * @brief
+         *
+         * @return uint32 records dropped because the queue was full
+         */
+        uint32 GetDroppedCount() const { return m_dropped; }
+
+        /**
+         * @brief
+         *
+         * @return uint32 highest queue depth seen
+         */
+        uint32 GetMaxQueueDepth() const { return m_maxDepth; }
+
+    private:
+        typedef std::vector<LogRecord> RecordList;
+
+        /**
+         * @brief
+         *
+         * @param records
+         */
+        static void WriteRecords(RecordList const& records);
+        /**
+         * @brief WriteRecords() with write(2) only, for the crash handler
+         *
+         * @param records
+         */
+        static void WriteRecordsFromCrashHandler(RecordList const& records);
+
+        ACE_Thread_Mutex m_lock; /**< guards all members below */
+        ACE_Condition_Thread_Mutex m_wakeup; /**< signaled when records are queued or on stop */
+        ACE_Condition_Thread_Mutex m_drained; /**< signaled after a batch was written */
+        RecordList m_queue; /**< records waiting for the writer */
+        RecordList m_batch; /**< records the writer thread is writing, only swapped and cleared under the lock */
+        std::atomic<bool> m_batchFlushed; /**< m_batch has reached the files, the crash handler must not write it again */
+        size_t m_maxQueued; /**< TODO */
+        FILE* m_reportFile; /**< TODO */
+        bool m_running; /**< TODO */
+        bool m_writing; /**< writer is currently outside the lock writing a batch */
+        uint32 m_dropped; /**< TODO */
+        uint32 m_reportedDropped; /**< dropped records already reported in the log */
+        uint32 m_maxDepth; /**< TODO */
+};
+
+#endif
@@ -24,15 +24,22 @@
 
 #include "EventProcessor.h"
 
+#include <cstring>
+
 EventProcessor::EventProcessor()
 {
     m_time = 0;
+    m_wheelTime = 0;
+    m_wheel = NULL;
+    m_freeNodes = NULL;
+    m_eventCount = 0;
     m_aborting = false;
 }
 
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
+    ReleaseWheel();
 }
 
 void EventProcessor::Update(uint32 p_time)
@@ -40,27 +47,86 @@ void EventProcessor::Update(uint32 p_time)
     // update time
     m_time += p_time;
 
-    // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    // main event loop, walks the first level slot by slot but skips runs of empty slots
+    while (m_wheelTime <= m_time)
     {
-        // get and remove event from queue
-        BasicEvent* Event = i->second;
-        m_events.erase(i);
+        if (!m_eventCount)
+        {
+            // nothing queued, no slot needs to be visited
+            m_wheelTime = m_time + 1;
+            break;
+        }
+
+        uint32 slot = uint32(m_wheelTime & (EVENT_WHEEL_SLOTS - 1));
+        if (!slot)
+        {
+            // start of a new first level round, bring down the events of the higher levels that fall into it
+            for (uint32 level = 1; level < EVENT_WHEEL_LEVELS; ++level)
+            {
+                uint32 shift = level * EVENT_WHEEL_BITS;
+                if (m_wheelTime & ((uint64(1) << shift) - 1))
+                {
+                    break;
+                }
+                Cascade(level, uint32((m_wheelTime >> shift) & (EVENT_WHEEL_SLOTS - 1)));
+            }
+            if (!(m_wheelTime & ((uint64(1) << (EVENT_WHEEL_LEVELS * EVENT_WHEEL_BITS)) - 1)))
+            {
+                Cascade(EVENT_WHEEL_LEVELS, 0);
+            }
+        }
 
-        if (!Event->to_Abort)
+        // events added while executing may land in this slot again, keep going until it is empty
+        EventSlot& current = m_wheel->slots[0][slot];
+        while (EventNode* node = current.head)
         {
-            if (Event->Execute(m_time, p_time))
+            // get and remove event from queue
+            current.head = node->next;
+            if (!current.head)
             {
-                // completely destroy event if it is not re-added
+                current.tail = NULL;
+            }
+            BasicEvent* Event = node->event;
+            FreeNode(node);
+            --m_eventCount;
+
+            if (!Event->to_Abort)
+            {
+                if (Event->Execute(m_time, p_time))
+                {
+                    // completely destroy event if it is not re-added
+                    delete Event;
+                }
+            }
+            else
+            {
+                Event->Abort(m_time);
                 delete Event;
             }
         }
-        else
+        m_wheel->occupied[0] &= ~(uint32(1) << slot);
+
+        // continue with the next occupied slot of this round, or the start of the next round
+        uint32 pending = slot + 1 < EVENT_WHEEL_SLOTS ? m_wheel->occupied[0] & (~uint32(0) << (slot + 1)) : 0;
+        uint64 roundStart = m_wheelTime - slot;
+        uint64 next = roundStart + EVENT_WHEEL_SLOTS;
+        for (uint32 i = slot + 1; pending && i < EVENT_WHEEL_SLOTS; ++i)
         {
-            Event->Abort(m_time);
-            delete Event;
+            if (pending & (uint32(1) << i))
+            {
+                next = roundStart + i;
+                break;
+            }
         }
+
+        // never step over the start of a round, the higher levels cascade there
+        m_wheelTime = next <= m_time ? next : m_time + 1;
+    }
+
+    // most units only have events queued now and then, do not keep the wheel around between them
+    if (!m_eventCount && m_wheel)
+    {
+        ReleaseWheel();
     }
 }
 
@@ -69,30 +135,23 @@ void EventProcessor::KillAllEvents(bool force)
     // prevent event insertions
     m_aborting = true;
 
-    // first, abort all existing events
-    for (EventList::iterator i = m_events.begin(); i != m_events.end();)
+    if (!m_wheel)
     {
-        EventList::iterator i_old = i;
-        ++i;
+        return;
+    }
 
-        i_old->second->to_Abort = true;
-        i_old->second->Abort(m_time);
-        if (force || i_old->second->IsDeletable())
+    // first, abort all existing events
+    for (uint32 level = 0; level < EVENT_WHEEL_LEVELS; ++level)
+    {
+        for (uint32 slot = 0; slot < EVENT_WHEEL_SLOTS; ++slot)
         {
-            delete i_old->second;
-
-            if (!force)                                     // need per-element cleanup
+            if (!AbortSlot(m_wheel->slots[level][slot], force))
             {
-                m_events.erase(i_old);
+                m_wheel->occupied[level] &= ~(uint32(1) << slot);
             }
         }
     }
-
-    // fast clear event list (in force case)
-    if (force)
-    {
-        m_events.clear();
-    }
+    AbortSlot(m_wheel->overflow, force);
 }
 
 void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime)
@@ -103,10 +162,140 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
     }
 
     Event->m_execTime = e_time;
-    m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+
+    EventNode* node = AllocateNode();
+    node->event = Event;
+    node->time = e_time;
+    Schedule(node);
+    ++m_eventCount;
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset)
 {
     return m_time + t_offset;
 }
+
+void EventProcessor::Schedule(EventNode* node)
+{
+    if (!m_wheel)
+    {
+        m_wheel = new EventWheel;
+        memset(m_wheel, 0, sizeof(EventWheel));
+    }
+
+    // events already due are run at the next processed millisecond
+    uint64 time = node->time > m_wheelTime ? node->time : m_wheelTime;
+    uint64 delta = time - m_wheelTime;
+
+    EventSlot* list = &m_wheel->overflow;
+    for (uint32 level = 0; level < EVENT_WHEEL_LEVELS; ++level)
+    {
+        uint32 shift = level * EVENT_WHEEL_BITS;
+        if (delta < (uint64(1) << (shift + EVENT_WHEEL_BITS)))
+        {
+            uint32 slot = uint32((time >> shift) & (EVENT_WHEEL_SLOTS - 1));
+            list = &m_wheel->slots[level][slot];
+            m_wheel->occupied[level] |= uint32(1) << slot;
+            break;
+        }
+    }
+
+    node->next = NULL;
+    if (list->tail)
+    {
+        list->tail->next = node;
+    }
+    else
+    {
+        list->head = node;
+    }
+    list->tail = node;
+}
+
+void EventProcessor::Cascade(uint32 level, uint32 slot)
+{
+    EventSlot& list = level < EVENT_WHEEL_LEVELS ? m_wheel->slots[level][slot] : m_wheel->overflow;
+    EventNode* node = list.head;
+    list.head = list.tail = NULL;
+    if (level < EVENT_WHEEL_LEVELS)
+    {
+        m_wheel->occupied[level] &= ~(uint32(1) << slot);
+    }
+
+    // keep the order of the events, they are re-placed relative to the new wheel position
+    while (node)
+    {
+        EventNode* next = node->next;
+        Schedule(node);
+        node = next;
+    }
+}
+
+bool EventProcessor::AbortSlot(EventSlot& list, bool force)
+{
+    // detach the list, events that are kept alive are put back in the same slot
+    EventNode* node = list.head;
+    list.head = list.tail = NULL;
+
+    while (node)
+    {
+        EventNode* next = node->next;
+
+        node->event->to_Abort = true;
+        node->event->Abort(m_time);
+        if (force || node->event->IsDeletable())
+        {
+            delete node->event;
+            FreeNode(node);
+            --m_eventCount;
+        }
+        else
+        {
+            node->next = NULL;
+            if (list.tail)
+            {
+                list.tail->next = node;
+            }
+            else
+            {
+                list.head = node;
+            }
+            list.tail = node;
+        }
+
+        node = next;
+    }
+
+    return list.head != NULL;
+}
+
+void EventProcessor::ReleaseWheel()
+{
+    delete m_wheel;
+    m_wheel = NULL;
+
+    while (m_freeNodes)
+    {
+        EventNode* node = m_freeNodes;
+        m_freeNodes = node->next;
+        delete node;
+    }
+}
+
+EventProcessor::EventNode* EventProcessor::AllocateNode()
+{
+    if (!m_freeNodes)
+    {
+        return new EventNode;
+    }
+
+    EventNode* node = m_freeNodes;
+    m_freeNodes = node->next;
+    return node;
+}
+
+void EventProcessor::FreeNode(EventNode* node)
+{
+    node->next = m_freeNodes;
+    m_freeNodes = node;
+}
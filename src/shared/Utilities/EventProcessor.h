@@ -27,8 +27,6 @@
 
 #include "Platform/Define.h"
 
-#include <map>
-
 /**
  * @brief Note. All times are in milliseconds here.
  *
@@ -86,13 +84,20 @@ class BasicEvent
 };
 
 /**
- * @brief
+ * @brief Wheel geometry: EVENT_WHEEL_LEVELS levels of EVENT_WHEEL_SLOTS slots,
+ * each level covering EVENT_WHEEL_SLOTS times the span of the level below.
+ * The first level has a resolution of one millisecond, events due further than
+ * the last level can cover wait in an overflow list.
  *
  */
-typedef std::multimap<uint64, BasicEvent*> EventList;
+#define EVENT_WHEEL_BITS   5
+#define EVENT_WHEEL_SLOTS  (1 << EVENT_WHEEL_BITS)
+#define EVENT_WHEEL_LEVELS 4
 
 /**
- * @brief
+ * @brief Hierarchical timing wheel of events. Adding an event and expiring it is
+ * constant time; events are kept in pooled list nodes so scheduling does not
+ * allocate once the pool is warm.
  *
  */
 class EventProcessor
@@ -140,8 +145,82 @@ class EventProcessor
 
     protected:
 
+        /**
+         * @brief Pooled list node holding one queued event
+         *
+         */
+        struct EventNode
+        {
+            BasicEvent* event; /**< TODO */
+            uint64 time; /**< TODO */
+            EventNode* next; /**< TODO */
+        };
+
+        /**
+         * @brief FIFO list of the events sharing a wheel slot
+         *
+         */
+        struct EventSlot
+        {
+            EventNode* head; /**< TODO */
+            EventNode* tail; /**< TODO */
+        };
+
+        /**
+         * @brief Wheel storage, only allocated while events are queued
+         *
+         */
+        struct EventWheel
+        {
+            EventSlot slots[EVENT_WHEEL_LEVELS][EVENT_WHEEL_SLOTS]; /**< TODO */
+            uint32 occupied[EVENT_WHEEL_LEVELS]; /**< bit per non empty slot */
+            EventSlot overflow; /**< events beyond the span of the last level */
+        };
+
+        /**
+         * @brief Places the node into the slot matching its time relative to the wheel position
+         *
+         * @param node
+         */
+        void Schedule(EventNode* node);
+        /**
+         * @brief Moves the events of a higher level slot down once the wheel reaches it
+         *
+         * @param level
+         * @param slot
+         */
+        void Cascade(uint32 level, uint32 slot);
+        /**
+         * @brief Aborts the events of a slot, deleting the deletable ones
+         *
+         * @param list
+         * @param force
+         * @return bool true if events were kept in the slot
+         */
+        bool AbortSlot(EventSlot& list, bool force);
+        /**
+         * @brief Frees the wheel and the pooled nodes once no event is queued
+         *
+         */
+        void ReleaseWheel();
+        /**
+         * @brief
+         *
+         * @return EventNode
+         */
+        EventNode* AllocateNode();
+        /**
+         * @brief
+         *
+         * @param node
+         */
+        void FreeNode(EventNode* node);
+
         uint64 m_time; /**< TODO */
-        EventList m_events; /**< TODO */
+        uint64 m_wheelTime; /**< next millisecond the wheel has to process */
+        EventWheel* m_wheel; /**< TODO */
+        EventNode* m_freeNodes; /**< pool of unused nodes */
+        uint32 m_eventCount; /**< TODO */
         bool m_aborting; /**< TODO */
 };
 
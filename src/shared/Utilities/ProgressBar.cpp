@@ -128,3 +128,8 @@ void BarGoLink::SetOutputState(bool on)
 {
     m_showOutput = on;
 }
+
+bool BarGoLink::GetOutputState()
+{
+    return m_showOutput;
+}
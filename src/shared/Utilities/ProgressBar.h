@@ -59,6 +59,12 @@ class BarGoLink
          * @param on
          */
         static void SetOutputState(bool on);
+        /**
+         * @brief
+         *
+         * @return bool true if progress bars are printed
+         */
+        static bool GetOutputState();
     private:
         /**
          * @brief
@@ -31,13 +31,16 @@
 #include "MapTree.h"
 #include "ModelInstance.h"
 
+#include <thread>
+
 using namespace VMAP;
 
 namespace MMAP
 {
     MapBuilder::MapBuilder(float maxWalkableAngle, bool skipLiquid,
                            bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-                           bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath) :
+                           bool debugOutput, bool bigBaseUnit, const char* offMeshFilePath,
+                           uint32 threads) :
         m_terrainBuilder(NULL),
         m_debugOutput(debugOutput),
         m_skipContinents(skipContinents),
@@ -46,7 +49,9 @@ namespace MMAP
         m_maxWalkableAngle(maxWalkableAngle),
         m_bigBaseUnit(bigBaseUnit),
         m_rcContext(NULL),
-        m_offMeshFilePath(offMeshFilePath)
+        m_offMeshFilePath(offMeshFilePath),
+        m_skipLiquid(skipLiquid),
+        m_threads(threads ? threads : 1)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid);
 
@@ -157,9 +162,11 @@ namespace MMAP
             uint32 mapID = (*it).first;
             if (!shouldSkipMap(mapID))
             {
-                buildMap(mapID);
+                queueMap(mapID);
             }
         }
+
+        processQueue();
     }
 
     /**************************************************************************/
@@ -180,7 +187,14 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildMap(uint32 mapID)
     {
-        printf("Building map %03u:\n", mapID);
+        queueMap(mapID);
+        processQueue();
+    }
+
+    /**************************************************************************/
+    void MapBuilder::queueMap(uint32 mapID)
+    {
+        printf("Queueing map %03u:\n", mapID);
 
         set<uint32>* tiles = getTileList(mapID);
 
@@ -213,8 +227,11 @@ namespace MMAP
             return;
         }
 
-        // now start building mmtiles for each tile
+        // queue mmtiles for each tile, the navmesh is released by the worker finishing the last one
         printf("We have %u tiles.                          \n", (unsigned int)tiles->size());
+        MapJob* job = new MapJob(mapID, navMesh);
+
+        std::lock_guard<std::mutex> guard(m_queueLock);
         for (set<uint32>::iterator it = tiles->begin(); it != tiles->end(); ++it)
         {
             uint32 tileX, tileY;
@@ -227,25 +244,106 @@ namespace MMAP
                 continue;
             }
 
-            buildTile(mapID, tileX, tileY, navMesh);
+            m_tileQueue.push_back(TileJob(job, tileX, tileY));
+            ++job->pendingTiles;
         }
 
-        dtFreeNavMesh(navMesh);
+        if (!job->pendingTiles)
+        {
+            dtFreeNavMesh(navMesh);
+            delete job;
+
+            printf("Map %03u complete!                      \n\n", mapID);
+        }
+    }
+
+    /**************************************************************************/
+    void MapBuilder::processQueue()
+    {
+        if (m_threads <= 1)
+        {
+            buildWorker();
+            return;
+        }
+
+        printf("Building tiles using %u threads\n", m_threads);
 
-        printf("Complete!                               \n\n");
+        vector<std::thread> workers;
+        for (uint32 i = 0; i < m_threads; ++i)
+        {
+            workers.push_back(std::thread(&MapBuilder::buildWorker, this));
+        }
+
+        for (uint32 i = 0; i < workers.size(); ++i)
+        {
+            workers[i].join();
+        }
     }
+
+    /**************************************************************************/
+    void MapBuilder::buildWorker()
+    {
+        // recast context and terrain builder are not thread safe, every worker owns its own
+        TerrainBuilder terrainBuilder(m_skipLiquid);
+        rcContext context(false);
+
+        TileJob job;
+        while (popTile(job))
+        {
+            buildTile(job.map->mapID, job.tileX, job.tileY, job.map->navMesh, terrainBuilder, context);
+            finishTile(job.map);
+        }
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::popTile(TileJob& job)
+    {
+        std::lock_guard<std::mutex> guard(m_queueLock);
+        if (m_tileQueue.empty())
+        {
+            return false;
+        }
+
+        job = m_tileQueue.front();
+        m_tileQueue.pop_front();
+        return true;
+    }
+
+    /**************************************************************************/
+    void MapBuilder::finishTile(MapJob* job)
+    {
+        {
+            std::lock_guard<std::mutex> guard(m_queueLock);
+            if (--job->pendingTiles)
+            {
+                return;
+            }
+        }
+
+        dtFreeNavMesh(job->navMesh);
+        printf("Map %03u complete!                      \n\n", job->mapID);
+        delete job;
+    }
+
     /**************************************************************************/
     void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    {
+        buildTile(mapID, tileX, tileY, navMesh, *m_terrainBuilder, *m_rcContext);
+    }
+
+    /**************************************************************************/
+    void MapBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh,
+                               TerrainBuilder& terrainBuilder, rcContext& context)
     {
         printf("Building map %03u, tile [%02u,%02u]\n", mapID, tileX, tileY);
 
         MeshData meshData;
 
         // get heightmap data
-        m_terrainBuilder->loadMap(mapID, tileX, tileY, meshData);
+        terrainBuilder.loadMap(mapID, tileX, tileY, meshData);
 
         // get model data
-        m_terrainBuilder->loadVMap(mapID, tileY, tileX, meshData);
+        terrainBuilder.loadVMap(mapID, tileY, tileX, meshData);
 
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
@@ -271,10 +369,10 @@ namespace MMAP
         float bmin[3], bmax[3];
         getTileBounds(tileX, tileY, allVerts.getCArray(), allVerts.size() / 3, bmin, bmax);
 
-        m_terrainBuilder->loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
+        terrainBuilder.loadOffMeshConnections(mapID, tileX, tileY, meshData, m_offMeshFilePath);
 
         // build navmesh tile
-        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
+        buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh, context);
     }
 
     /**************************************************************************/
@@ -415,7 +513,7 @@ namespace MMAP
     /**************************************************************************/
     void MapBuilder::buildMoveMapTile(uint32 mapID, uint32 tileX, uint32 tileY,
                                       MeshData& meshData, float bmin[3], float bmax[3],
-                                      dtNavMesh* navMesh)
+                                      dtNavMesh* navMesh, rcContext& context)
     {
         // console output
         char tileString[10];
@@ -500,7 +598,7 @@ namespace MMAP
 
                 // build heightfield
                 tile.solid = rcAllocHeightfield();
-                if (!tile.solid || !rcCreateHeightfield(m_rcContext, *tile.solid, tileCfg.width, tileCfg.height, tileCfg.bmin, tileCfg.bmax, tileCfg.cs, tileCfg.ch))
+                if (!tile.solid || !rcCreateHeightfield(&context, *tile.solid, tileCfg.width, tileCfg.height, tileCfg.bmin, tileCfg.bmax, tileCfg.cs, tileCfg.ch))
                 {
                     printf("%s Failed building heightfield!            \n", tileString);
                     continue;
@@ -509,45 +607,45 @@ namespace MMAP
                 // mark all walkable tiles, both liquids and solids
                 unsigned char* triFlags = new unsigned char[tTriCount];
                 memset(triFlags, NAV_GROUND, tTriCount * sizeof(unsigned char));
-                rcClearUnwalkableTriangles(m_rcContext, tileCfg.walkableSlopeAngle, tVerts, tVertCount, tTris, tTriCount, triFlags);
-                rcRasterizeTriangles(m_rcContext, tVerts, tVertCount, tTris, triFlags, tTriCount, *tile.solid, config.walkableClimb);
+                rcClearUnwalkableTriangles(&context, tileCfg.walkableSlopeAngle, tVerts, tVertCount, tTris, tTriCount, triFlags);
+                rcRasterizeTriangles(&context, tVerts, tVertCount, tTris, triFlags, tTriCount, *tile.solid, config.walkableClimb);
                 delete [] triFlags;
 
-                rcFilterLowHangingWalkableObstacles(m_rcContext, config.walkableClimb, *tile.solid);
-                rcFilterLedgeSpans(m_rcContext, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid);
-                rcFilterWalkableLowHeightSpans(m_rcContext, tileCfg.walkableHeight, *tile.solid);
+                rcFilterLowHangingWalkableObstacles(&context, config.walkableClimb, *tile.solid);
+                rcFilterLedgeSpans(&context, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid);
+                rcFilterWalkableLowHeightSpans(&context, tileCfg.walkableHeight, *tile.solid);
 
-                rcRasterizeTriangles(m_rcContext, lVerts, lVertCount, lTris, lTriFlags, lTriCount, *tile.solid, config.walkableClimb);
+                rcRasterizeTriangles(&context, lVerts, lVertCount, lTris, lTriFlags, lTriCount, *tile.solid, config.walkableClimb);
 
                 // compact heightfield spans
                 tile.chf = rcAllocCompactHeightfield();
-                if (!tile.chf || !rcBuildCompactHeightfield(m_rcContext, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid, *tile.chf))
+                if (!tile.chf || !rcBuildCompactHeightfield(&context, tileCfg.walkableHeight, tileCfg.walkableClimb, *tile.solid, *tile.chf))
                 {
                     printf("%s Failed compacting heightfield!            \n", tileString);
                     continue;
                 }
 
                 // build polymesh intermediates
-                if (!rcErodeWalkableArea(m_rcContext, config.walkableRadius, *tile.chf))
+                if (!rcErodeWalkableArea(&context, config.walkableRadius, *tile.chf))
                 {
                     printf("%s Failed eroding area!                    \n", tileString);
                     continue;
                 }
 
-                if (!rcBuildDistanceField(m_rcContext, *tile.chf))
+                if (!rcBuildDistanceField(&context, *tile.chf))
                 {
                     printf("%s Failed building distance field!         \n", tileString);
                     continue;
                 }
 
-                if (!rcBuildRegions(m_rcContext, *tile.chf, tileCfg.borderSize, tileCfg.minRegionArea, tileCfg.mergeRegionArea))
+                if (!rcBuildRegions(&context, *tile.chf, tileCfg.borderSize, tileCfg.minRegionArea, tileCfg.mergeRegionArea))
                 {
                     printf("%s Failed building regions!                \n", tileString);
                     continue;
                 }
 
                 tile.cset = rcAllocContourSet();
-                if (!tile.cset || !rcBuildContours(m_rcContext, *tile.chf, tileCfg.maxSimplificationError, tileCfg.maxEdgeLen, *tile.cset))
+                if (!tile.cset || !rcBuildContours(&context, *tile.chf, tileCfg.maxSimplificationError, tileCfg.maxEdgeLen, *tile.cset))
                 {
                     printf("%s Failed building contours!               \n", tileString);
                     continue;
@@ -555,14 +653,14 @@ namespace MMAP
 
                 // build polymesh
                 tile.pmesh = rcAllocPolyMesh();
-                if (!tile.pmesh || !rcBuildPolyMesh(m_rcContext, *tile.cset, tileCfg.maxVertsPerPoly, *tile.pmesh))
+                if (!tile.pmesh || !rcBuildPolyMesh(&context, *tile.cset, tileCfg.maxVertsPerPoly, *tile.pmesh))
                 {
                     printf("%s Failed building polymesh!               \n", tileString);
                     continue;
                 }
 
                 tile.dmesh = rcAllocPolyMeshDetail();
-                if (!tile.dmesh || !rcBuildPolyMeshDetail(m_rcContext, *tile.pmesh, *tile.chf, tileCfg.detailSampleDist, tileCfg    .detailSampleMaxError, *tile.dmesh))
+                if (!tile.dmesh || !rcBuildPolyMeshDetail(&context, *tile.pmesh, *tile.chf, tileCfg.detailSampleDist, tileCfg    .detailSampleMaxError, *tile.dmesh))
                 {
                     printf("%s Failed building polymesh detail!        \n", tileString);
                     continue;
@@ -619,7 +717,7 @@ namespace MMAP
             delete [] tiles;
             return;
         }
-        rcMergePolyMeshes(m_rcContext, pmmerge, nmerge, *iv.polyMesh);
+        rcMergePolyMeshes(&context, pmmerge, nmerge, *iv.polyMesh);
 
         iv.polyMeshDetail = rcAllocPolyMeshDetail();
         if (!iv.polyMeshDetail)
@@ -628,7 +726,7 @@ namespace MMAP
             delete [] tiles;
             return;
         }
-        rcMergePolyMeshDetails(m_rcContext, dmmerge, nmerge, *iv.polyMeshDetail);
+        rcMergePolyMeshDetails(&context, dmmerge, nmerge, *iv.polyMeshDetail);
 
         // free things up
         delete [] pmmerge;
@@ -735,14 +833,21 @@ namespace MMAP
                 continue;
             }
 
-            dtTileRef tileRef = 0;
-            // DT_TILE_FREE_DATA tells detour to unallocate memory when the tile
-            // is removed via removeTile()
-            dtStatus dtResult = navMesh->addTile(navData, navDataSize, DT_TILE_FREE_DATA, 0, &tileRef);
-            if (!tileRef || dtStatusFailed(dtResult))
+            // the tile is only added to validate it against the navmesh, it is owned by us
+            // (no DT_TILE_FREE_DATA) and released after it has been written to disk
             {
-                printf(" Failed adding tile %s to navmesh !           \n", tileString);
-                continue;
+                std::lock_guard<std::mutex> guard(m_navMeshLock);
+
+                dtTileRef tileRef = 0;
+                dtStatus dtResult = navMesh->addTile(navData, navDataSize, 0, 0, &tileRef);
+                if (!tileRef || dtStatusFailed(dtResult))
+                {
+                    printf(" Failed adding tile %s to navmesh !           \n", tileString);
+                    dtFree(navData);
+                    continue;
+                }
+
+                navMesh->removeTile(tileRef, NULL, NULL);
             }
 
             // file output
@@ -754,13 +859,13 @@ namespace MMAP
                 char message[1024];
                 sprintf(message, "Failed to open %s for writing!\n", fileName);
                 perror(message);
-                navMesh->removeTile(tileRef, NULL, NULL);
+                dtFree(navData);
                 continue;
             }
 
             // write header
             MmapTileHeader header;
-            header.usesLiquids = m_terrainBuilder->usesLiquids();
+            header.usesLiquids = !m_skipLiquid;
             header.size = uint32(navDataSize);
             fwrite(&header, sizeof(MmapTileHeader), 1, file);
 
@@ -768,8 +873,7 @@ namespace MMAP
             fwrite(navData, sizeof(unsigned char), navDataSize, file);
             fclose(file);
 
-            // now that tile is written to disk, we can unload it
-            navMesh->removeTile(tileRef, NULL, NULL);
+            dtFree(navData);
         }
         while (0);
 
@@ -28,6 +28,8 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <deque>
+#include <mutex>
 
 #include <Recast.h>
 #include <DetourNavMesh.h>
@@ -80,6 +82,33 @@ namespace MMAP
         rcPolyMeshDetail* dmesh; /**< TODO */
     };
 
+    /**
+     * @brief navmesh of a map shared by all of its queued tiles
+     *
+     */
+    struct MapJob
+    {
+        MapJob(uint32 id, dtNavMesh* mesh) : mapID(id), navMesh(mesh), pendingTiles(0) {}
+
+        uint32 mapID; /**< TODO */
+        dtNavMesh* navMesh; /**< TODO */
+        uint32 pendingTiles; /**< tiles not built yet, the navmesh is freed when this drops to 0 */
+    };
+
+    /**
+     * @brief a single tile waiting to be built by one of the workers
+     *
+     */
+    struct TileJob
+    {
+        TileJob() : map(NULL), tileX(0), tileY(0) {}
+        TileJob(MapJob* job, uint32 x, uint32 y) : map(job), tileX(x), tileY(y) {}
+
+        MapJob* map; /**< TODO */
+        uint32 tileX; /**< TODO */
+        uint32 tileY; /**< TODO */
+    };
+
     /**
      * @brief
      *
@@ -98,6 +127,7 @@ namespace MMAP
              * @param debugOutput
              * @param bigBaseUnit
              * @param offMeshFilePath
+             * @param threads number of tiles built concurrently
              */
             MapBuilder(float maxWalkableAngle   = 60.f,
                        bool skipLiquid          = false,
@@ -106,7 +136,8 @@ namespace MMAP
                        bool skipBattlegrounds   = false,
                        bool debugOutput         = false,
                        bool bigBaseUnit         = false,
-                       const char* offMeshFilePath = NULL);
+                       const char* offMeshFilePath = NULL,
+                       uint32 threads           = 1);
 
             /**
              * @brief
@@ -147,6 +178,53 @@ namespace MMAP
             void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
 
         private:
+            /**
+             * @brief builds an mmap tile using the given per-thread terrain builder and recast context
+             *
+             * @param mapID
+             * @param tileX
+             * @param tileY
+             * @param navMesh
+             * @param terrainBuilder
+             * @param context
+             */
+            void buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh,
+                           TerrainBuilder& terrainBuilder, rcContext& context);
+
+            /**
+             * @brief creates the navmesh of a map and queues all of its tiles for building
+             *
+             * @param mapID
+             */
+            void queueMap(uint32 mapID);
+
+            /**
+             * @brief builds all queued tiles, using m_threads workers
+             *
+             */
+            void processQueue();
+
+            /**
+             * @brief worker loop, takes tiles from the queue until it is empty
+             *
+             */
+            void buildWorker();
+
+            /**
+             * @brief
+             *
+             * @param job
+             * @return bool false if the queue is empty
+             */
+            bool popTile(TileJob& job);
+
+            /**
+             * @brief
+             *
+             * @param job
+             */
+            void finishTile(MapJob* job);
+
             /**
              * @brief detect maps and tiles
              *
@@ -178,6 +256,7 @@ namespace MMAP
              * @param bmin[]
              * @param bmax[]
              * @param navMesh
+             * @param context
              */
             void buildMoveMapTile(uint32 mapID,
                                   uint32 tileX,
@@ -185,7 +264,8 @@ namespace MMAP
                                   MeshData& meshData,
                                   float bmin[3],
                                   float bmax[3],
-                                  dtNavMesh* navMesh);
+                                  dtNavMesh* navMesh,
+                                  rcContext& context);
 
             /**
              * @brief
@@ -238,6 +318,13 @@ namespace MMAP
             bool m_bigBaseUnit; /**< TODO */
 
             rcContext* m_rcContext; /**< build performance - not really used for now */
+
+            bool m_skipLiquid; /**< TODO */
+            uint32 m_threads; /**< number of worker threads building tiles */
+
+            deque<TileJob> m_tileQueue; /**< tiles waiting to be built */
+            std::mutex m_queueLock; /**< guards m_tileQueue and MapJob::pendingTiles */
+            std::mutex m_navMeshLock; /**< dtNavMesh is not thread safe, guards addTile/removeTile */
     };
 }
 